@@ -0,0 +1,67 @@
+#!/bin/sh
+# Measures OCC startup phases over repeated runs
+#
+# Usage: build/startup_benchmark.sh <path to occ> [runs] [cold|warm]
+#
+# Each run starts occ with --startup-report --exit-after-startup, so it needs a display (or
+# e.g. SDL_VIDEODRIVER=dummy). Cold runs drop the OS file cache before each start, which needs sudo.
+# Prints one CSV line per phase: mode,phase,runs,mean_ms,min_ms,max_ms
+set -e
+
+OCC=$1
+RUNS=${2:-10}
+MODE=${3:-warm}
+
+if [ -z "$OCC" ]; then
+  echo "Usage: $0 <path to occ> [runs] [cold|warm]" >&2
+  exit 1
+fi
+
+drop_caches() {
+  case "$(uname)" in
+    Linux)
+      sync
+      echo 3 | sudo tee /proc/sys/vm/drop_caches > /dev/null
+      ;;
+    Darwin)
+      sudo purge
+      ;;
+    *)
+      echo "Cold starts are not supported on $(uname)" >&2
+      exit 1
+      ;;
+  esac
+}
+
+REPORTS=$(mktemp)
+trap 'rm -f "$REPORTS"' EXIT
+
+# Warm the cache once so that the first warm run is not a cold one
+if [ "$MODE" = "warm" ]; then
+  "$OCC" --exit-after-startup > /dev/null
+fi
+
+i=0
+while [ $i -lt "$RUNS" ]; do
+  if [ "$MODE" = "cold" ]; then
+    drop_caches
+  fi
+  "$OCC" --startup-report --exit-after-startup | grep -v '^phase,' >> "$REPORTS"
+  i=$((i + 1))
+done
+
+echo "mode,phase,runs,mean_ms,min_ms,max_ms"
+awk -F, -v mode="$MODE" '
+  !($1 in count) { order[n++] = $1; min[$1] = $3; max[$1] = $3 }
+  {
+    count[$1]++
+    sum[$1] += $3
+    if ($3 < min[$1]) min[$1] = $3
+    if ($3 > max[$1]) max[$1] = $3
+  }
+  END {
+    for (i = 0; i < n; i++) {
+      p = order[i]
+      printf "%s,%s,%d,%.3f,%.3f,%.3f\n", mode, p, count[p], sum[p] / count[p], min[p], max[p]
+    }
+  }' "$REPORTS"
@@ -1,6 +1,8 @@
 // Base class of enemies and hazards
 #pragma once
+#include <cstdint>
 #include <utility>
+#include <vector>
 
 #include "geometry.h"
 #include "misc.h"
@@ -33,12 +35,32 @@ enum class TouchType
 
 struct Level;
 struct Player;
+class Hazard;
 class LaserBeam;
+class Actor;
+
+// What an actor's think() does outside of the actor itself, applied in actor order after all actors have thought
+struct ActorIntents
+{
+  std::vector<SoundType> sounds;
+  // New hazards, owned by the level once applied
+  std::vector<Hazard*> spawned_hazards;
+  // The actor goes to sleep for this many ticks, see Level::sleep
+  unsigned sleep_ticks = 0;
+
+  void clear()
+  {
+    sounds.clear();
+    spawned_hazards.clear();
+    sleep_ticks = 0;
+  }
+  void apply(Actor& actor, AbstractSoundManager& sound_manager, Level& level);
+};
 
 class Actor
 {
  public:
-  Actor(geometry::Position position, geometry::Size size) : position(std::move(position)), size(std::move(size)) {}
+  Actor(geometry::Position position, geometry::Size size) : position(position), size(std::move(size)), prev_position(std::move(position)) {}
   virtual ~Actor() = default;
 
   virtual bool is_alive() const { return true; }
@@ -47,10 +69,16 @@ class Actor
   virtual bool is_solid_top([[maybe_unused]] const Level& level) const { return false; }
   virtual bool is_render_in_front() const { return false; }
 
-  virtual void update([[maybe_unused]] AbstractSoundManager& sound_manager,
-                      [[maybe_unused]] const geometry::Rectangle& player_rect,
-                      [[maybe_unused]] Level& level)
+  // Thinks and applies the intents right away, unless overridden
+  virtual void update(AbstractSoundManager& sound_manager, const geometry::Rectangle& player_rect, Level& level);
+  // First phase of a two-phase update: only reads the level and only changes the actor itself, everything else is
+  // put in intents. This lets actors think in parallel, see GameImpl::think
+  // Returns false if the actor can't think, then it has to be update()d instead
+  virtual bool think([[maybe_unused]] const geometry::Rectangle& player_rect,
+                     [[maybe_unused]] const Level& level,
+                     [[maybe_unused]] ActorIntents& intents)
   {
+    return false;
   }
   virtual bool interact([[maybe_unused]] AbstractSoundManager& sound_manager, [[maybe_unused]] Level& level) { return false; };
   virtual std::vector<ObjectDef> get_sprites(const Level& level) const = 0;
@@ -79,6 +107,11 @@ class Actor
   geometry::Position position;
   geometry::Size size;
   geometry::Rectangle rect() const { return {position, size}; }
+  // Position at the start of the last game tick, used to interpolate rendering between ticks
+  geometry::Position prev_position;
+  // Set by Level::sleep while the actor isn't updated, it still gets touched and hit
+  bool asleep = false;
+  uint64_t wake_tick = 0;
 
  protected:
   std::vector<geometry::Rectangle> create_detection_rects(const int dx,
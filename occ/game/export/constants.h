@@ -4,5 +4,4 @@ static constexpr int SPRITE_W = 16;
 static constexpr int SPRITE_H = 16;
 
 static constexpr int FPS = 70;
-static constexpr int FRAMES_PER_TICK = 4;
-static constexpr int MS_PER_TICK = 1000 * FRAMES_PER_TICK / FPS;  // 17.5~ ticks per second
+static constexpr int FRAMES_PER_TICK = 4;  // 17.5 ticks per second
@@ -92,7 +92,7 @@ class Bigfoot : public FacePlayerOnHit
  public:
   Bigfoot(geometry::Position position) : FacePlayerOnHit(position - geometry::Position(0, 16), geometry::Size(16, 32), 5) {}
 
-  virtual void update(AbstractSoundManager& sound_manager, const geometry::Rectangle& player_rect, Level& level) override;
+  virtual bool think(const geometry::Rectangle& player_rect, const Level& level, ActorIntents& intents) override;
   virtual std::vector<ObjectDef> get_sprites(const Level& level) const override;
   virtual std::vector<geometry::Rectangle> get_detection_rects(const Level& level) const override
   {
@@ -169,7 +169,7 @@ class SlimeLeaver : public Enemy
  public:
   SlimeLeaver(geometry::Position position) : Enemy(position, geometry::Size(16, 16), 2) {}
 
-  virtual void update(AbstractSoundManager& sound_manager, const geometry::Rectangle& player_rect, Level& level) override;
+  virtual bool think(const geometry::Rectangle& player_rect, const Level& level, ActorIntents& intents) override;
   virtual std::vector<ObjectDef> get_sprites(const Level& level) const override;
   virtual void on_death(AbstractSoundManager& sound_manager, Level& level) override;
   virtual int get_points() const override { return 100; }
@@ -267,7 +267,7 @@ class Spider : public Enemy
  public:
   Spider(geometry::Position position) : Enemy(position, geometry::Size(16, 16), 1) {}
 
-  virtual void update(AbstractSoundManager& sound_manager, const geometry::Rectangle& player_rect, Level& level) override;
+  virtual bool think(const geometry::Rectangle& player_rect, const Level& level, ActorIntents& intents) override;
   virtual std::vector<ObjectDef> get_sprites(const Level& level) const override;
   virtual std::vector<geometry::Rectangle> get_detection_rects(const Level& level) const override
   {
@@ -304,7 +304,7 @@ class Rockman : public Enemy
  public:
   Rockman(geometry::Position position) : Enemy(position, geometry::Size(16, 16), 1) {}
 
-  virtual void update(AbstractSoundManager& sound_manager, const geometry::Rectangle& player_rect, Level& level) override;
+  virtual bool think(const geometry::Rectangle& player_rect, const Level& level, ActorIntents& intents) override;
   virtual std::vector<ObjectDef> get_sprites(const Level& level) const override;
   virtual std::vector<geometry::Rectangle> get_detection_rects(const Level& level) const override;
   virtual int get_points() const override { return 100; }
@@ -335,7 +335,7 @@ class MineCart : public Enemy
  public:
   MineCart(geometry::Position position) : Enemy(position, geometry::Size(16, 16), 1) {}
 
-  virtual void update(AbstractSoundManager& sound_manager, const geometry::Rectangle& player_rect, Level& level) override;
+  virtual bool think(const geometry::Rectangle& player_rect, const Level& level, ActorIntents& intents) override;
   virtual std::vector<ObjectDef> get_sprites(const Level& level) const override;
   // TODO: confirm points
   virtual int get_points() const override { return 100; }
@@ -369,7 +369,7 @@ class Caterpillar : public Enemy
  public:
   Caterpillar(geometry::Position position);
 
-  virtual void update(AbstractSoundManager& sound_manager, const geometry::Rectangle& player_rect, Level& level) override;
+  virtual bool think(const geometry::Rectangle& player_rect, const Level& level, ActorIntents& intents) override;
   virtual std::vector<ObjectDef> get_sprites(const Level& level) const override;
   virtual int get_points() const override { return 1000; }
   virtual bool is_tough() const override
@@ -449,7 +449,7 @@ class Triceratops
  public:
   Triceratops(geometry::Position position) : FacePlayerOnHit(position, geometry::Size(48, 16), 5) {}
 
-  virtual void update(AbstractSoundManager& sound_manager, const geometry::Rectangle& player_rect, Level& level) override;
+  virtual bool think(const geometry::Rectangle& player_rect, const Level& level, ActorIntents& intents) override;
   virtual std::vector<ObjectDef> get_sprites(const Level& level) const override;
   virtual int get_points() const override { return 5000; }
   virtual const std::vector<Sprite>* get_explosion_sprites() const override { return &Explosion::sprites_implosion; }
@@ -526,7 +526,7 @@ class WallMonster : public Enemy
  public:
   WallMonster(geometry::Position position, bool left) : Enemy(position, geometry::Size(16, 16), 1), left_(left) {}
 
-  virtual void update(AbstractSoundManager& sound_manager, const geometry::Rectangle& player_rect, Level& level) override;
+  virtual bool think(const geometry::Rectangle& player_rect, const Level& level, ActorIntents& intents) override;
   virtual std::vector<ObjectDef> get_sprites(const Level& level) const override;
   virtual int get_points() const override { return 100; }
   virtual bool is_tough() const override { return true; }
@@ -714,7 +714,7 @@ class Ostrich
   // Walks left/right, shoots fast projectiles when player is in front (doesn't turn on hit)
  public:
   Ostrich(geometry::Position position) : Enemy(position, geometry::Size(16, 16), 2) {}
-  virtual void update(AbstractSoundManager& sound_manager, const geometry::Rectangle& player_rect, Level& level) override;
+  virtual bool think(const geometry::Rectangle& player_rect, const Level& level, ActorIntents& intents) override;
   virtual std::vector<ObjectDef> get_sprites([[maybe_unused]] const Level& level) const override
   {
     return {{position, static_cast<int>(left_ ? Sprite::SPRITE_OSTRICH_L_1 : Sprite::SPRITE_OSTRICH_R_1) + frame_, false}};
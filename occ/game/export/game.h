@@ -46,4 +46,7 @@ class Game
   virtual std::wstring get_debug_info() const = 0;
 
   LevelId entering_level = LevelId::INTRO;
+  // The level behind an entrance or the exit is loaded in the background when the player gets this close (pixels)
+  // 0 disables loading ahead
+  int prefetch_distance = 3 * 16;
 };
@@ -40,7 +40,7 @@ class Laser
  public:
   Laser(geometry::Position position, bool left, bool moving = false) : Hazard(position), left_(left), moving_(moving) {}
 
-  virtual void update(AbstractSoundManager& sound_manager, const geometry::Rectangle& player_rect, Level& level) override;
+  virtual bool think(const geometry::Rectangle& player_rect, const Level& level, ActorIntents& intents) override;
   virtual std::vector<ObjectDef> get_sprites([[maybe_unused]] const Level& level) const override
   {
     return {{position, static_cast<int>(left_ ? Sprite::SPRITE_LASER_L : Sprite::SPRITE_LASER_R), false}};
@@ -227,7 +227,7 @@ class Thorn : public Hazard
  public:
   Thorn(geometry::Position position) : Hazard(position) {}
 
-  virtual void update(AbstractSoundManager& sound_manager, const geometry::Rectangle& player_rect, Level& level) override;
+  virtual bool think(const geometry::Rectangle& player_rect, const Level& level, ActorIntents& intents) override;
   virtual std::vector<ObjectDef> get_sprites([[maybe_unused]] const Level& level) const override
   {
     return {{position, static_cast<int>(Sprite::SPRITE_THORN_1) + frame_, false}};
@@ -430,7 +430,7 @@ class Hammer : public Hazard
  public:
   Hammer(geometry::Position position) : Hazard(position, geometry::Size(32, 32)) {}
 
-  virtual void update(AbstractSoundManager& sound_manager, const geometry::Rectangle& player_rect, Level& level) override;
+  virtual bool think(const geometry::Rectangle& player_rect, const Level& level, ActorIntents& intents) override;
   virtual std::vector<ObjectDef> get_sprites([[maybe_unused]] const Level& level) const override
   {
     return {
@@ -475,7 +475,7 @@ class Flame : public Hazard
  public:
   Flame(geometry::Position position) : Hazard(position) {}
 
-  virtual void update(AbstractSoundManager& sound_manager, const geometry::Rectangle& player_rect, Level& level) override;
+  virtual bool think(const geometry::Rectangle& player_rect, const Level& level, ActorIntents& intents) override;
   virtual std::vector<ObjectDef> get_sprites(const Level& level) const override;
   virtual TouchType on_touch([[maybe_unused]] const Player& player,
                              [[maybe_unused]] AbstractSoundManager& sound_manager,
@@ -512,7 +512,7 @@ class Stalactite : public Hazard
   Stalactite(geometry::Position position) : Hazard(position) {}
 
   virtual bool is_alive() const override { return position.y() < 1000; }
-  virtual void update(AbstractSoundManager& sound_manager, const geometry::Rectangle& player_rect, Level& level) override;
+  virtual bool think(const geometry::Rectangle& player_rect, const Level& level, ActorIntents& intents) override;
   virtual std::vector<ObjectDef> get_sprites([[maybe_unused]] const Level& level) const override
   {
     return {{position, static_cast<int>(Sprite::SPRITE_STALACTITE_1), false}};
@@ -45,4 +45,6 @@ struct Object
   bool reverse;
   int flags;
   Vector<double> parallax;
+  // How far the object moved during the last game tick, used to interpolate rendering between ticks
+  geometry::Position motion;
 };
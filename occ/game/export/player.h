@@ -32,6 +32,8 @@ struct Player
 
   geometry::Position position = geometry::Position(0, 0);
   geometry::Position position_last = geometry::Position(0, 0);
+  // Position at the start of the last game tick, used to interpolate rendering between ticks
+  geometry::Position prev_position = geometry::Position(0, 0);
   Vector<int> velocity = Vector<int>(0, 0);
   enum class Direction
   {
@@ -50,6 +52,9 @@ struct Player
   unsigned jump_tick = 0u;
 
   bool falling = false;
+  // Handle of the Level::supporters entry the player stands on, or -1; found again when the player moves
+  int support = -1;
+  geometry::Position support_position = geometry::Position(-1, -1);
 
   bool shooting = false;
 
@@ -31,6 +31,8 @@ class Tile
   bool is_render_in_front() const { return (flags_ & 0x20) != 0; }
   bool is_solid_for_slime() const { return !!(flags_ & (TILE_BLOCKS_SLIME | TILE_SOLID)); }
 
+  bool operator==(const Tile& other) const = default;
+
   static const Tile INVALID;
 
  private:
@@ -4,6 +4,32 @@
 #include "player.h"
 #include <cmath>
 
+void ActorIntents::apply(Actor& actor, AbstractSoundManager& sound_manager, Level& level)
+{
+  for (const auto sound : sounds)
+  {
+    sound_manager.play_sound(sound);
+  }
+  for (auto* hazard : spawned_hazards)
+  {
+    level.hazards.emplace_back(hazard);
+  }
+  if (sleep_ticks > 0)
+  {
+    level.sleep(actor, sleep_ticks);
+  }
+  clear();
+}
+
+void Actor::update(AbstractSoundManager& sound_manager, const geometry::Rectangle& player_rect, Level& level)
+{
+  ActorIntents intents;
+  if (think(player_rect, level, intents))
+  {
+    intents.apply(*this, sound_manager, level);
+  }
+}
+
 std::vector<geometry::Rectangle> Actor::create_detection_rects(const int dx,
                                                                const int dy,
                                                                const Level& level,
@@ -60,7 +60,7 @@ bool FacePlayerOnHit::on_hit(const geometry::Rectangle& rect,
   return Enemy::on_hit(rect, sound_manager, player_rect, level, power);
 }
 
-void Bigfoot::update([[maybe_unused]] AbstractSoundManager& sound_manager, const geometry::Rectangle& player_rect, Level& level)
+bool Bigfoot::think(const geometry::Rectangle& player_rect, const Level& level, [[maybe_unused]] ActorIntents& intents)
 {
   frame_++;
   if (frame_ == 8)
@@ -81,6 +81,7 @@ void Bigfoot::update([[maybe_unused]] AbstractSoundManager& sound_manager, const
   {
     running_ = true;
   }
+  return true;
 }
 
 bool Bigfoot::on_hit(const geometry::Rectangle& rect,
@@ -200,9 +201,7 @@ std::vector<ObjectDef> Slime::get_sprites([[maybe_unused]] const Level& level) c
   return {{position, static_cast<int>(s) + frame_, false}};
 }
 
-void SlimeLeaver::update([[maybe_unused]] AbstractSoundManager& sound_manager,
-                         [[maybe_unused]] const geometry::Rectangle& player_rect,
-                         Level& level)
+bool SlimeLeaver::think([[maybe_unused]] const geometry::Rectangle& player_rect, const Level& level, [[maybe_unused]] ActorIntents& intents)
 {
   // State changes / pause
   frame_++;
@@ -230,6 +229,7 @@ void SlimeLeaver::update([[maybe_unused]] AbstractSoundManager& sound_manager,
       position -= d;
     }
   }
+  return true;
 }
 
 void SlimeLeaver::on_death(AbstractSoundManager& sound_manager, Level& level)
@@ -247,7 +247,7 @@ std::vector<ObjectDef> SlimeLeaver::get_sprites([[maybe_unused]] const Level& le
   return {{position, static_cast<int>(s) + frame, false}};
 }
 
-void Spider::update(AbstractSoundManager& sound_manager, const geometry::Rectangle& player_rect, Level& level)
+bool Spider::think(const geometry::Rectangle& player_rect, const Level& level, ActorIntents& intents)
 {
   frame_++;
   if (frame_ == 8)
@@ -265,9 +265,10 @@ void Spider::update(AbstractSoundManager& sound_manager, const geometry::Rectang
   if (child_ == nullptr && geometry::is_any_colliding(get_detection_rects(level), player_rect))
   {
     child_ = new SpiderWeb(position, *this);
-    level.hazards.emplace_back(child_);
-    sound_manager.play_sound(SoundType::SOUND_LASER_FIRE);
+    intents.spawned_hazards.push_back(child_);
+    intents.sounds.push_back(SoundType::SOUND_LASER_FIRE);
   }
+  return true;
 }
 
 std::vector<ObjectDef> Spider::get_sprites([[maybe_unused]] const Level& level) const
@@ -284,7 +285,7 @@ void Spider::on_death(AbstractSoundManager& sound_manager, Level& level)
   }
 }
 
-void Rockman::update([[maybe_unused]] AbstractSoundManager& sound_manager, const geometry::Rectangle& player_rect, Level& level)
+bool Rockman::think(const geometry::Rectangle& player_rect, const Level& level, [[maybe_unused]] ActorIntents& intents)
 {
   // Wake on detection
   if (asleep_)
@@ -324,6 +325,7 @@ void Rockman::update([[maybe_unused]] AbstractSoundManager& sound_manager, const
       frame_ = 4;
     }
   }
+  return true;
 }
 
 std::vector<ObjectDef> Rockman::get_sprites([[maybe_unused]] const Level& level) const
@@ -340,9 +342,7 @@ std::vector<geometry::Rectangle> Rockman::get_detection_rects(const Level& level
   return lr;
 }
 
-void MineCart::update([[maybe_unused]] AbstractSoundManager& sound_manager,
-                      [[maybe_unused]] const geometry::Rectangle& player_rect,
-                      Level& level)
+bool MineCart::think([[maybe_unused]] const geometry::Rectangle& player_rect, const Level& level, ActorIntents& intents)
 {
   if (pause_frame_ > 0)
   {
@@ -359,11 +359,14 @@ void MineCart::update([[maybe_unused]] AbstractSoundManager& sound_manager,
     position += d;
     if (should_reverse(level))
     {
+      // Pause for 56 ticks, sleeping through all but the last
       position -= d;
-      pause_frame_ = 56;
+      pause_frame_ = 1;
+      intents.sleep_ticks = 55;
       left_ = !left_;
     }
   }
+  return true;
 }
 
 std::vector<ObjectDef> MineCart::get_sprites([[maybe_unused]] const Level& level) const
@@ -375,9 +378,7 @@ std::vector<ObjectDef> MineCart::get_sprites([[maybe_unused]] const Level& level
 
 Caterpillar::Caterpillar(geometry::Position position) : Enemy(position, geometry::Size(16, 16), 1) {}
 
-void Caterpillar::update([[maybe_unused]] AbstractSoundManager& sound_manager,
-                         [[maybe_unused]] const geometry::Rectangle& player_rect,
-                         Level& level)
+bool Caterpillar::think([[maybe_unused]] const geometry::Rectangle& player_rect, const Level& level, [[maybe_unused]] ActorIntents& intents)
 {
   frame_++;
   const auto d = geometry::Position(left_ ? -2 : 2, 0);
@@ -391,6 +392,7 @@ void Caterpillar::update([[maybe_unused]] AbstractSoundManager& sound_manager,
   {
     frame_ = 0;
   }
+  return true;
 }
 
 std::vector<ObjectDef> Caterpillar::get_sprites([[maybe_unused]] const Level& level) const
@@ -507,9 +509,7 @@ void Snoozer::on_death(AbstractSoundManager& sound_manager, Level& level)
   }
 }
 
-void Triceratops::update([[maybe_unused]] AbstractSoundManager& sound_manager,
-                         [[maybe_unused]] const geometry::Rectangle& player_rect,
-                         Level& level)
+bool Triceratops::think(const geometry::Rectangle& player_rect, const Level& level, ActorIntents& intents)
 {
   frame_++;
   const auto d = geometry::Position(left_ ? -2 : 2, 0);
@@ -522,10 +522,11 @@ void Triceratops::update([[maybe_unused]] AbstractSoundManager& sound_manager,
   // Shoot player immediately
   if (child_ == nullptr && geometry::is_any_colliding(get_detection_rects(level), player_rect))
   {
-    sound_manager.play_sound(SoundType::SOUND_LASER_FIRE);
+    intents.sounds.push_back(SoundType::SOUND_LASER_FIRE);
     child_ = new TriceratopsShot(position, left_, *this);
-    level.hazards.emplace_back(child_);
+    intents.spawned_hazards.push_back(child_);
   }
+  return true;
 }
 
 std::vector<ObjectDef> Triceratops::get_sprites([[maybe_unused]] const Level& level) const
@@ -578,7 +579,7 @@ void Bat::update([[maybe_unused]] AbstractSoundManager& sound_manager,
   next_reverse_--;
 }
 
-void WallMonster::update([[maybe_unused]] AbstractSoundManager& sound_manager, const geometry::Rectangle& player_rect, Level& level)
+bool WallMonster::think(const geometry::Rectangle& player_rect, const Level& level, [[maybe_unused]] ActorIntents& intents)
 {
   const auto detection_rects = get_detection_rects(level);
   if (geometry::isColliding(detection_rects[0], player_rect))
@@ -597,6 +598,7 @@ void WallMonster::update([[maybe_unused]] AbstractSoundManager& sound_manager, c
   {
     frame_--;
   }
+  return true;
 }
 
 std::vector<ObjectDef> WallMonster::get_sprites([[maybe_unused]] const Level& level) const
@@ -911,7 +913,7 @@ void EyeMonster::on_death(AbstractSoundManager& sound_manager, Level& level)
   }
 }
 
-void Ostrich::update(AbstractSoundManager& sound_manager, const geometry::Rectangle& player_rect, Level& level)
+bool Ostrich::think(const geometry::Rectangle& player_rect, const Level& level, ActorIntents& intents)
 {
   frame_++;
   if (frame_ == 12)
@@ -934,13 +936,14 @@ void Ostrich::update(AbstractSoundManager& sound_manager, const geometry::Rectan
     }
     if (next_shoot_ == 0 && geometry::is_any_colliding(get_detection_rects(level), player_rect))
     {
-      sound_manager.play_sound(SoundType::SOUND_LASER_FIRE);
+      intents.sounds.push_back(SoundType::SOUND_LASER_FIRE);
       child_ = new Bullet(position, left_, *this);
-      level.hazards.emplace_back(child_);
+      intents.spawned_hazards.push_back(child_);
       // Shoot shortly after last shot
       next_shoot_ = 10;
     }
   }
+  return true;
 }
 
 void Ostrich::on_death(AbstractSoundManager& sound_manager, Level& level)
@@ -1,5 +1,6 @@
 #include "game_impl.h"
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <sstream>
@@ -8,6 +9,7 @@
 #include "level_loader.h"
 #include "logger.h"
 #include "misc.h"
+#include "think.h"
 
 #define MAX_AMMO 99
 #define AMMO_AMOUNT 5
@@ -24,11 +26,41 @@ bool GameImpl::init(AbstractSoundManager& sound_manager,
                     const LevelId previous_level)
 {
   sound_manager_ = &sound_manager;
-  level_ = LevelLoader::load(exe_data, level, player_state);
+  exe_data_ = &exe_data;
+  player_state_ = player_state;
+  if (level_ && level_->level_id == LevelId::MAIN_LEVEL && level >= LevelId::LEVEL_1)
+  {
+    // Keep the main level as it is while the player is in a sub-level
+    suspended_main_level_ = std::move(level_);
+    suspended_levels_completed_ = player_state.levels_completed;
+  }
+  level_.reset();
+  if (level == LevelId::MAIN_LEVEL && suspended_main_level_)
+  {
+    level_ = resume_main_level(player_state, previous_level);
+  }
+  else if (level < LevelId::LEVEL_1)
+  {
+    // A new game or the finale, the main level is loaded again if needed
+    suspended_main_level_.reset();
+  }
+  if (!level_)
+  {
+    level_ = prefetcher_.take(level, player_state);
+  }
+  if (!level_)
+  {
+    level_ = load_level_(exe_data, level, player_state);
+  }
   if (!level_)
   {
     return false;
   }
+  if (level == LevelId::INTRO)
+  {
+    // The intro always ends in the main level
+    prefetcher_.prefetch(exe_data, LevelId::MAIN_LEVEL, player_state);
+  }
 
   player_ = Player();
   player_.position = level_->get_player_start_pos(previous_level);
@@ -54,14 +86,34 @@ void GameImpl::update(unsigned game_tick, const PlayerInput& player_input)
 {
   (void)game_tick;  // Not needed atm
 
+  level_->tick++;
+
   // Clear objects_
   objects_.clear();
 
+  // Remember where everything was, the renderer interpolates between the previous and current positions
+  player_.prev_position = player_.position;
+  const auto remember_positions = [](auto& actors)
+  {
+    for (auto& actor : actors)
+    {
+      actor->prev_position = actor->position;
+    }
+  };
+  remember_positions(level_->actors);
+  remember_positions(level_->enemies);
+  remember_positions(level_->hazards);
+
   // Update the level (e.g. moving platforms and other objects)
   // TODO: don't update enemies off screen
   update_level();
   update_actors();
   update_missile();
+  // Sleeping enemies and hazards don't notice time passing while it is stopped
+  if (player_.stop_tick == 0)
+  {
+    level_->advance_sleepers();
+  }
   update_enemies();
   update_hazards();
 
@@ -113,32 +165,13 @@ std::wstring GameImpl::get_debug_info() const
 void GameImpl::update_level()
 {
   level_->dv = geometry::Position();
-
-  // Update all MovingPlatforms
-  for (auto& platform : level_->moving_platforms)
-  {
-    // Update platform
-    const auto player_on_platform = (player_.position.y() + player_.size.y() == platform.position.y()) &&
-      (player_.position.x() < platform.position.x() + SPRITE_W) && (player_.position.x() + player_.size.x() > platform.position.x());
-
-    platform.update(*level_);
-
-    // Move player if standing on platform
-    if (player_on_platform)
-    {
-      // Only move player if not colliding with any static objects
-      const auto new_player_pos = player_.position + platform.get_velocity(*level_);
-      if (!level_->collides_solid(new_player_pos, player_.size))
-      {
-        player_.position = new_player_pos;
-      }
-    }
-  }
+  level_->update_moving_platforms(player_);
 
   // Add moving platforms to objects_
   for (auto& platform : level_->moving_platforms)
   {
     objects_.emplace_back(platform.position, platform.get_sprite());
+    objects_.back().motion = platform.position - platform.prev_position;
   }
 
   // Add entrances
@@ -146,6 +179,10 @@ void GameImpl::update_level()
   {
     if (entrance.state != EntranceState::COMPLETE)
     {
+      if (is_near_player({entrance.position, SPRITE_W, SPRITE_H}))
+      {
+        prefetcher_.prefetch(*exe_data_, static_cast<LevelId>(entrance.level), player_state_);
+      }
       entrance.state = geometry::isColliding({player_.position, player_.size}, {entrance.position, SPRITE_W, SPRITE_H})
         ? EntranceState::OPEN
         : EntranceState::CLOSED;
@@ -165,6 +202,23 @@ void GameImpl::update_level()
   // Add exit
   if (level_->exit)
   {
+    if (!level_->exit->open && is_near_player({level_->exit->position, SPRITE_W, 2 * SPRITE_H}))
+    {
+      // Same as GameState::reset(): the level will be completed when exiting
+      auto state = player_state_;
+      if (level_->level_id >= LevelId::LEVEL_1)
+      {
+        state.levels_completed[static_cast<int>(level_->level_id)] = true;
+      }
+      if (state.has_completed_all_levels())
+      {
+        prefetcher_.prefetch(*exe_data_, LevelId::FINALE, state);
+      }
+      else if (!suspended_main_level_)
+      {
+        prefetcher_.prefetch(*exe_data_, LevelId::MAIN_LEVEL, state);
+      }
+    }
     if (!level_->exit->open)
     {
       const bool can_exit = !level_->has_crystals || level_->crystals <= 0;
@@ -185,22 +239,50 @@ void GameImpl::update_level()
   }
 
   // Falling rocks
-  if (level_->falling_rock_ticks == 0)
+  if (level_->tick >= level_->falling_rocks_tick)
   {
     for (const auto& area : level_->falling_rocks_areas)
     {
       if (geometry::isColliding(area, player_.rect()))
       {
-        level_->falling_rock_ticks = 40;
+        level_->falling_rocks_tick = level_->tick + 40;
         // Spawn inside detection area
         level_->hazards.emplace_back(new FallingRock({area.position.x() + static_cast<int>(rand() % area.size.x()), 0}));
       }
     }
   }
-  if (level_->falling_rock_ticks > 0)
+}
+
+std::unique_ptr<Level> GameImpl::resume_main_level(const PlayerState& player_state, const LevelId previous_level)
+{
+  auto level = std::move(suspended_main_level_);
+  // Only the level just left can have been completed since, otherwise (e.g. another saved game) load it again
+  for (size_t i = 0; i < player_state.levels_completed.size(); i++)
+  {
+    if (static_cast<LevelId>(i) != previous_level && player_state.levels_completed[i] != suspended_levels_completed_[i])
+    {
+      return nullptr;
+    }
+  }
+  if (previous_level >= LevelId::LEVEL_1 && player_state.levels_completed[static_cast<int>(previous_level)])
   {
-    level_->falling_rock_ticks--;
+    for (auto& entrance : level->entrances)
+    {
+      if (entrance.level == static_cast<int>(previous_level))
+      {
+        entrance.state = EntranceState::COMPLETE;
+      }
+    }
+    level->show_player_controls = false;
   }
+  return level;
+}
+
+bool GameImpl::is_near_player(const geometry::Rectangle& rect) const
+{
+  const auto d = prefetch_distance;
+  return d > 0 &&
+    geometry::isColliding(player_.rect(), {rect.position - geometry::Position(d, d), rect.size + geometry::Size(2 * d, 2 * d)});
 }
 
 void GameImpl::update_player(const PlayerInput& player_input)
@@ -372,6 +454,8 @@ void GameImpl::update_missile()
     }
   }
 
+  const auto missile_prev_position = missile_.alive ? missile_.position : geometry::Position();
+  const auto missile_was_alive = missile_.alive;
   if (missile_.update(*sound_manager_, player_.rect(), *level_))
   {
     level_->particles.emplace_back(new Explosion(missile_.position, Explosion::sprites_explosion));
@@ -400,13 +484,21 @@ void GameImpl::update_missile()
   if (missile_.alive)
   {
     objects_.emplace_back(missile_.position, missile_.get_sprite(), missile_.get_num_sprites(), false, 0);
+    if (missile_was_alive)
+    {
+      objects_.back().motion = missile_.position - missile_prev_position;
+    }
   }
 }
 
 void GameImpl::update_enemies()
 {
+  // Enemies think first, possibly in parallel, then their intents are applied in order
+  // Enemies that can't think are updated in the same order, so the result doesn't depend on the threads
+  const size_t num_thought = player_.stop_tick == 0 ? think(level_->enemies) : 0;
+  size_t k = 0;
   // Iterate by index as we may add/remove enemies while updating
-  for (int i = 0; i < static_cast<int>(level_->enemies.size()); i++)
+  for (int i = 0; i < static_cast<int>(level_->enemies.size()); i++, k++)
   {
     auto e = level_->enemies[i].get();
     if (player_.stop_tick == 0)
@@ -416,7 +508,14 @@ void GameImpl::update_enemies()
       //       This is applicable for when the player gets hit as well
       //       Modify the sprite on the fly / some kind of filter, or pre-create white sprites
       //       for all player and enemy sprite when loading sprites?
-      e->update(*sound_manager_, player_.rect(), *level_);
+      if (k < num_thought && thought_[k])
+      {
+        intents_[k].apply(*e, *sound_manager_, *level_);
+      }
+      else if (!e->asleep)
+      {
+        e->update(*sound_manager_, player_.rect(), *level_);
+      }
     }
 
     // Check if enemy died
@@ -439,6 +538,7 @@ void GameImpl::update_enemies()
       }
 
       // Remove enemy
+      level_->wake(*e);
       level_->enemies.erase(level_->enemies.begin() + i);
       i--;
     }
@@ -447,17 +547,28 @@ void GameImpl::update_enemies()
 
 void GameImpl::update_hazards()
 {
-  for (int i = 0; i < static_cast<int>(level_->hazards.size());)
+  // Same as update_enemies(): hazards spawned during the update haven't thought and are updated directly
+  const size_t num_thought = player_.stop_tick == 0 ? think(level_->hazards) : 0;
+  size_t k = 0;
+  for (int i = 0; i < static_cast<int>(level_->hazards.size()); k++)
   {
     auto h = level_->hazards[i].get();
     if (player_.stop_tick == 0)
     {
-      h->update(*sound_manager_, player_.rect(), *level_);
+      if (k < num_thought && thought_[k])
+      {
+        intents_[k].apply(*h, *sound_manager_, *level_);
+      }
+      else if (!h->asleep)
+      {
+        h->update(*sound_manager_, player_.rect(), *level_);
+      }
     }
 
     // Check if hazard died
     if (!h->is_alive())
     {
+      level_->wake(*h);
       level_->hazards.erase(level_->hazards.begin() + i);
     }
     else
@@ -471,12 +582,27 @@ void GameImpl::update_hazards()
                               (sprite_pos.bright ? static_cast<int>(ObjectFlags::BRIGHT) : 0) +
                                 (h->is_render_in_front() ? static_cast<int>(ObjectFlags::RENDER_IN_FRONT) : 0),
                               h->parallax());
+        objects_.back().motion = h->position - h->prev_position;
       }
       i++;
     }
   }
 }
 
+template <typename T>
+size_t GameImpl::think(const std::vector<std::unique_ptr<T>>& actors)
+{
+  // Below this, handing out the work costs more than it saves
+  static constexpr size_t MIN_PARALLEL_ACTORS = 256;
+  const bool parallel = actors.size() >= MIN_PARALLEL_ACTORS;
+  if (parallel && !think_pool_)
+  {
+    think_pool_ = std::make_unique<ThreadPool>();
+  }
+  think_actors(actors, player_.rect(), *level_, intents_, thought_, parallel ? think_pool_.get() : nullptr);
+  return actors.size();
+}
+
 void GameImpl::update_actors()
 {
   const auto prect = geometry::Rectangle(player_.position, player_.size);
@@ -511,6 +637,7 @@ void GameImpl::update_actors()
                               (sprite_pos.bright ? static_cast<int>(ObjectFlags::BRIGHT) : 0) +
                                 (a->is_render_in_front() ? static_cast<int>(ObjectFlags::RENDER_IN_FRONT) : 0),
                               a->parallax());
+        objects_.back().motion = a->position - a->prev_position;
       }
       it++;
     }
@@ -2,21 +2,41 @@
 
 #include "game.h"
 
+#include <array>
+#include <cstdint>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "enemy.h"
 #include "hazard.h"
 #include "level.h"
+#include "level_loader.h"
+#include "level_prefetcher.h"
 #include "missile.h"
 #include "particle.h"
 #include "player.h"
 #include "player_input.h"
+#include "player_state.h"
+#include "thread_pool.h"
 
 class GameImpl : public Game
 {
  public:
-  GameImpl() : player_(), level_(), objects_(), score_(0u), num_ammo_(0u), missile_() {}
+  GameImpl() : GameImpl(LevelLoader::load) {}
+  // Loads levels with load_level instead of LevelLoader::load, e.g. to run without the game data
+  explicit GameImpl(LevelPrefetcher::Load load_level)
+    : player_state_(0),
+      player_(),
+      level_(),
+      objects_(),
+      score_(0u),
+      num_ammo_(0u),
+      missile_(),
+      load_level_(load_level),
+      prefetcher_(std::move(load_level))
+  {
+  }
 
   virtual bool init(AbstractSoundManager& sound_manager,
                     const ExeData& exe_data,
@@ -47,8 +67,19 @@ class GameImpl : public Game
   void update_hazards();
   void update_actors();
   void touch_actor(Actor& actor);
+  // Takes the suspended main level, with the entrance of the level just left updated; null if it can't be resumed
+  std::unique_ptr<Level> resume_main_level(const PlayerState& player_state, const LevelId previous_level);
+  // Whether the player is within prefetch_distance of rect
+  bool is_near_player(const geometry::Rectangle& rect) const;
+  // Lets all actors think, in parallel if there are many; returns the number of actors that were asked
+  // Actor i thought if thought_[i], and then intents_[i] must be applied before the next think()
+  template <typename T>
+  size_t think(const std::vector<std::unique_ptr<T>>& actors);
 
   AbstractSoundManager* sound_manager_;
+  const ExeData* exe_data_ = nullptr;
+  // The state the level was loaded with
+  PlayerState player_state_;
   Player player_;
   std::unique_ptr<Level> level_;
   std::vector<Object> objects_;
@@ -57,4 +88,16 @@ class GameImpl : public Game
   unsigned num_ammo_;
 
   Missile missile_;
+
+  std::vector<ActorIntents> intents_;
+  // Not vector<bool> as it's written from several threads
+  std::vector<std::uint8_t> thought_;
+  // Created when a level first has enough actors to think in parallel
+  std::unique_ptr<ThreadPool> think_pool_;
+
+  // The main level while the player is in a sub-level, resumed when they return
+  std::unique_ptr<Level> suspended_main_level_;
+  std::array<bool, 20> suspended_levels_completed_ = {};
+  LevelPrefetcher::Load load_level_;
+  LevelPrefetcher prefetcher_;
 };
@@ -3,15 +3,15 @@
 #include "level.h"
 #include "player.h"
 
-void Laser::update(AbstractSoundManager& sound_manager, const geometry::Rectangle& player_rect, Level& level)
+bool Laser::think(const geometry::Rectangle& player_rect, const Level& level, ActorIntents& intents)
 {
   const bool can_fire = moving_ || (level.switch_flags & SWITCH_FLAG_LASERS);
   if (can_fire && child_ == nullptr && geometry::is_any_colliding(get_detection_rects(level), player_rect))
   {
     geometry::Position child_pos = position + geometry::Position(left_ ? -6 : 6, -1);
     child_ = new LaserBeam(child_pos, left_, *this);
-    level.hazards.emplace_back(child_);
-    sound_manager.play_sound(SoundType::SOUND_LASER_FIRE);
+    intents.spawned_hazards.push_back(child_);
+    intents.sounds.push_back(SoundType::SOUND_LASER_FIRE);
   }
   if (moving_)
   {
@@ -23,6 +23,7 @@ void Laser::update(AbstractSoundManager& sound_manager, const geometry::Rectangl
     }
     position += geometry::Position{0, dy};
   }
+  return true;
 }
 
 std::vector<geometry::Rectangle> Laser::get_detection_rects(const Level& level) const
@@ -111,13 +112,13 @@ void LaserBeam::update(AbstractSoundManager& sound_manager, const geometry::Rect
   }
 }
 
-void Thorn::update(AbstractSoundManager& sound_manager, const geometry::Rectangle& player_rect, Level& level)
+bool Thorn::think(const geometry::Rectangle& player_rect, const Level& level, ActorIntents& intents)
 {
   if (geometry::is_any_colliding(get_detection_rects(level), player_rect))
   {
     if (frame_ == 0)
     {
-      sound_manager.play_sound(SoundType::SOUND_THORN);
+      intents.sounds.push_back(SoundType::SOUND_THORN);
     }
     if (frame_ < 4)
     {
@@ -128,6 +129,7 @@ void Thorn::update(AbstractSoundManager& sound_manager, const geometry::Rectangl
   {
     frame_ = 0;
   }
+  return true;
 }
 
 void SpiderWeb::update([[maybe_unused]] AbstractSoundManager& sound_manager,
@@ -181,9 +183,7 @@ void Droplet::update([[maybe_unused]] AbstractSoundManager& sound_manager,
 }
 
 
-void Hammer::update(AbstractSoundManager& sound_manager,
-                    [[maybe_unused]] const geometry::Rectangle& player_rect,
-                    [[maybe_unused]] Level& level)
+bool Hammer::think([[maybe_unused]] const geometry::Rectangle& player_rect, const Level& level, ActorIntents& intents)
 {
   constexpr int BOTTOM_FRAMES = 18;
   if (frame_ > 0)
@@ -197,8 +197,10 @@ void Hammer::update(AbstractSoundManager& sound_manager,
     }
     else if (frame_ == BOTTOM_FRAMES - 2)
     {
-      // Return to bottom
+      // Return to bottom, then nothing happens until the last frame
       position += geometry::Position(0, 2);
+      intents.sleep_ticks = frame_ - 1;
+      frame_ = 1;
     }
     else if (frame_ == 0)
     {
@@ -224,23 +226,27 @@ void Hammer::update(AbstractSoundManager& sound_manager,
     {
       position -= geometry::Position(0, 8);
       frame_ = BOTTOM_FRAMES;
-      sound_manager.play_sound(SoundType::SOUND_HAMMER);
+      intents.sounds.push_back(SoundType::SOUND_HAMMER);
     }
   }
+  return true;
 }
 
 constexpr int FLAME_FRAME_TOTAL = 84;
 constexpr int FLAME_OFF_FRAMES = 28;
 
-void Flame::update([[maybe_unused]] AbstractSoundManager& sound_manager,
-                   [[maybe_unused]] const geometry::Rectangle& player_rect,
-                   [[maybe_unused]] Level& level)
+bool Flame::think([[maybe_unused]] const geometry::Rectangle& player_rect,
+                  [[maybe_unused]] const Level& level,
+                  ActorIntents& intents)
 {
   frame_++;
   if (frame_ == FLAME_FRAME_TOTAL)
   {
-    frame_ = 0;
+    // Off: sleep until the frame before the flame comes on
+    frame_ = FLAME_OFF_FRAMES - 1;
+    intents.sleep_ticks = FLAME_OFF_FRAMES - 1;
   }
+  return true;
 }
 
 std::vector<ObjectDef> Flame::get_sprites([[maybe_unused]] const Level& level) const
@@ -265,18 +271,19 @@ bool Flame::is_on() const
   return frame_ >= FLAME_OFF_FRAMES;
 }
 
-void Stalactite::update(AbstractSoundManager& sound_manager, const geometry::Rectangle& player_rect, Level& level)
+bool Stalactite::think(const geometry::Rectangle& player_rect, const Level& level, ActorIntents& intents)
 {
   if (asleep_ && geometry::is_any_colliding(get_detection_rects(level), player_rect))
   {
     asleep_ = false;
-    sound_manager.play_sound(SoundType::SOUND_STALACTITE_FALL);
+    intents.sounds.push_back(SoundType::SOUND_STALACTITE_FALL);
   }
   if (!asleep_)
   {
     // TODO: see if we can kill on collision
     position += geometry::Position{0, 8};
   }
+  return true;
 }
 
 void AirPipe::update([[maybe_unused]] AbstractSoundManager& sound_manager, const geometry::Rectangle& player_rect, Level& level)
@@ -399,6 +406,7 @@ void FallingSign::update([[maybe_unused]] AbstractSoundManager& sound_manager,
       sound_manager.play_sound(SoundType::SOUND_HAMMER);
       landed_ = true;
       falling_ = false;
+      level.add_supporter(rect(), false);
     }
   }
 }
@@ -1,6 +1,9 @@
 #include "level.h"
 
+#include <algorithm>
+
 #include "constants.h"
+#include "player.h"
 
 const Tile& Level::get_tile(const int x, const int y) const
 {
@@ -8,7 +11,7 @@ const Tile& Level::get_tile(const int x, const int y) const
   {
     return Tile::INVALID;
   }
-  return tiles[(y * width) + x];
+  return tiles->get(x, y);
 }
 
 int Level::get_bg(const int x, const int y) const
@@ -17,7 +20,7 @@ int Level::get_bg(const int x, const int y) const
   {
     return -1;
   }
-  return bgs[(y * width) + x];
+  return bgs->get(x, y);
 }
 
 bool Level::collides_solid(const geometry::Position& position,
@@ -71,17 +74,19 @@ bool Level::collides_solid_top(const geometry::Position& position, const geometr
     {
       return true;
     }
-    // Also check actors and hazards that are solid on top
-    for (const auto& a : actors)
-    {
-      if (a->is_solid_top(*this) && geometry::isColliding(geometry::Rectangle(a->position, a->size), {position, size}))
-      {
-        return true;
-      }
-    }
-    for (const auto& hazard : hazards)
+  }
+  // Also check actors and hazards that are solid on top, only the rows they can be in
+  if (supporter_rows.empty())
+  {
+    return false;
+  }
+  const geometry::Rectangle rect{position, size};
+  for (int row = supporter_row(position.y() - max_supporter_height + 1); row <= supporter_row(position.y() + size.y() - 1); row++)
+  {
+    for (const auto handle : supporter_rows[row])
     {
-      if (hazard->is_solid_top(*this) && geometry::isColliding(geometry::Rectangle(hazard->position, hazard->size), {position, size}))
+      const auto& supporter = supporters[handle];
+      if (!supporter.moving && geometry::isColliding(supporter.rect, rect))
       {
         return true;
       }
@@ -156,53 +161,143 @@ bool Level::player_on_platform(const geometry::Position& position, const geometr
     }
   }
 
-  // Check moving platforms
-  for (const auto& platform : moving_platforms)
+  // Player only collides if standing exactly on top of the supporter, just like with static platforms
+  return find_supporter(position - geometry::Position(0, 1), size) >= 0;
+}
+
+geometry::Position Level::get_player_start_pos(const LevelId previous_level) const
+{
+  for (const auto& entrance : entrances)
   {
-    // Player only collides if standing exactly on top of the platform, just like with static platforms
-    if ((position.y() + size.y() - 1 == platform.position.y()) && (position.x() < platform.position.x() + SPRITE_W) &&
-        (position.x() + size.x() > platform.position.x()))
+    if (entrance.level == static_cast<int>(previous_level))
     {
-      return true;
+      // Find free position to left or right of entrance
+      if (!collides_solid(entrance.position + geometry::Position(-SPRITE_W, 0), {SPRITE_W, SPRITE_H}))
+      {
+        return entrance.position + geometry::Position(-SPRITE_W, 0);
+      }
+      return entrance.position + geometry::Position(SPRITE_W, 0);
     }
   }
+  return player_spawn;
+}
 
-  // Check actors that are solid on top
-  for (const auto& a : actors)
+void Level::sleep(Actor& actor, unsigned ticks)
+{
+  wake(actor);
+  actor.asleep = true;
+  // Skip the next ticks updates
+  actor.wake_tick = sleepers.schedule(sleepers.now() + ticks + 1, &actor);
+}
+
+void Level::wake(Actor& actor)
+{
+  if (actor.asleep)
   {
-    if (a->is_solid_top(*this) && (position.y() + size.y() - 1 == a->position.y()) && (position.x() < a->position.x() + a->size.x()) &&
-        (position.x() + size.x() > a->position.x()))
-    {
-      return true;
-    }
+    sleepers.cancel(actor.wake_tick, &actor);
+    actor.asleep = false;
+  }
+}
+
+void Level::advance_sleepers()
+{
+  sleepers.advance([](Actor* actor) { actor->asleep = false; });
+}
+
+bool Level::Supporter::supports(const geometry::Position& position, const geometry::Size& size) const
+{
+  return (position.y() + size.y() == rect.position.y()) && (position.x() < rect.position.x() + rect.size.x()) &&
+    (position.x() + size.x() > rect.position.x());
+}
+
+int Level::add_supporter(const geometry::Rectangle& rect, const bool moving)
+{
+  if (supporter_rows.empty())
+  {
+    supporter_rows.resize(std::max(height, 1));
   }
+  const int handle = static_cast<int>(supporters.size());
+  supporters.push_back({rect, moving});
+  supporter_rows[supporter_row(rect.position.y())].push_back(handle);
+  max_supporter_height = std::max(max_supporter_height, rect.size.y());
+  return handle;
+}
 
-  // Check hazards that are solid on top
-  for (const auto& hazard : hazards)
+void Level::move_supporter(const int handle, const geometry::Position& position)
+{
+  auto& supporter = supporters[handle];
+  const int old_row = supporter_row(supporter.rect.position.y());
+  const int new_row = supporter_row(position.y());
+  supporter.rect.position = position;
+  if (old_row != new_row)
   {
-    if (hazard->is_solid_top(*this) && (position.y() + size.y() - 1 == hazard->position.y()) &&
-        (position.x() < hazard->position.x() + hazard->size.x()) && (position.x() + size.x() > hazard->position.x()))
+    auto& row = supporter_rows[old_row];
+    row.erase(std::find(row.begin(), row.end(), handle));
+    supporter_rows[new_row].push_back(handle);
+  }
+}
+
+int Level::find_supporter(const geometry::Position& position, const geometry::Size& size) const
+{
+  if (supporter_rows.empty())
+  {
+    return -1;
+  }
+  // Moving platforms first, as they carry what stands on them
+  int found = -1;
+  for (const auto handle : supporter_rows[supporter_row(position.y() + size.y())])
+  {
+    if (supporters[handle].supports(position, size) && (found < 0 || (supporters[handle].moving && !supporters[found].moving)))
     {
-      return true;
+      found = handle;
     }
   }
+  return found;
+}
 
-  return false;
+int Level::supporter_row(const int y) const
+{
+  return std::clamp(y / SPRITE_H, 0, static_cast<int>(supporter_rows.size()) - 1);
 }
 
-geometry::Position Level::get_player_start_pos(const LevelId previous_level) const
+void Level::update_moving_platforms(Player& player)
 {
-  for (const auto& entrance : entrances)
+  // What the player stands on only changes when the player or that supporter moves
+  if (player.position != player.support_position)
   {
-    if (entrance.level == static_cast<int>(previous_level))
+    player.support = find_supporter(player.position, player.size);
+    player.support_position = player.position;
+  }
+
+  for (auto& platform : moving_platforms)
+  {
+    platform.prev_position = platform.position;
+    platform.update(*this);
+    if (platform.position == platform.prev_position)
     {
-      // Find free position to left or right of entrance
-      if (!collides_solid(entrance.position + geometry::Position(-SPRITE_W, 0), {SPRITE_W, SPRITE_H}))
+      continue;
+    }
+    move_supporter(platform.supporter, platform.position);
+
+    if (player.support == platform.supporter)
+    {
+      // Move player with the platform, only if not colliding with any static objects
+      const auto new_player_pos = player.position + (platform.position - platform.prev_position);
+      if (!collides_solid(new_player_pos, player.size))
       {
-        return entrance.position + geometry::Position(-SPRITE_W, 0);
+        player.position = new_player_pos;
       }
-      return entrance.position + geometry::Position(SPRITE_W, 0);
+      else
+      {
+        player.support = find_supporter(player.position, player.size);
+      }
+      player.support_position = player.position;
+    }
+    else if (supporters[platform.supporter].supports(player.position, player.size))
+    {
+      // Platform moved under the player
+      player.support = platform.supporter;
     }
   }
-  return player_spawn;
 }
+
@@ -1,8 +1,10 @@
 #pragma once
 
 #include <bitset>
+#include <memory>
 #include <vector>
 
+#include "chunked_grid.h"
 #include "enemy.h"
 #include "entrance.h"
 #include "exit.h"
@@ -14,6 +16,7 @@
 #include "particle.h"
 #include "sprite.h"
 #include "tile.h"
+#include "timer_wheel.h"
 
 struct Player;
 
@@ -46,23 +49,56 @@ struct Level
   Hazard* collides_hazard(const geometry::Position& position, const geometry::Size& size) const;
   Enemy* collides_enemy(const geometry::Position& position, const geometry::Size& size) const;
   bool player_on_platform(const geometry::Position& position, const geometry::Size& size) const;
+
+  // Something besides tiles that can be stood on: a moving platform or an actor that is solid on top
+  struct Supporter
+  {
+    geometry::Rectangle rect;
+    // Moving platforms carry what stands on them
+    bool moving;
+
+    // Whether something at position stands right on top of it
+    bool supports(const geometry::Position& position, const geometry::Size& size) const;
+  };
+  // Registers a supporter, returns its handle; supporters stay for the rest of the level
+  int add_supporter(const geometry::Rectangle& rect, const bool moving);
+  void move_supporter(const int handle, const geometry::Position& position);
+  // Handle of the supporter something at position stands on, or -1
+  int find_supporter(const geometry::Position& position, const geometry::Size& size) const;
+  // Index into supporter_rows for a y coordinate
+  int supporter_row(const int y) const;
+  // Moves the moving platforms and carries the player along if it stands on one
+  void update_moving_platforms(Player& player);
+
   bool is_complete() const { return crystals == 0; }
   geometry::Position get_player_start_pos(const LevelId previous_level) const;
   bool is_space() const { return level_id == LevelId::INTRO || level_id == LevelId::FINALE; }
   void reverse_gravity() { gravity = -gravity; }
+  // The enemy or hazard isn't updated for the next ticks updates, e.g. while it waits with nothing to do
+  void sleep(Actor& actor, unsigned ticks);
+  // Cancels the sleep, must be called before a sleeping actor is destroyed
+  void wake(Actor& actor);
+  // Wakes the actors that are due, called once per tick in which enemies and hazards are updated
+  void advance_sleepers();
 
   // Helper fields for the level viewer
   std::vector<int> tile_ids;
   std::vector<bool> tile_unknown;
 
-  std::vector<int> bgs;
-  std::vector<Tile> tiles;
+  // Chunks without any tile or background aren't allocated; the rest of the level is stored in full
+  // Shared with the render snapshots, they don't change after loading
+  std::shared_ptr<ChunkedGrid<int>> bgs = std::make_shared<ChunkedGrid<int>>();
+  std::shared_ptr<ChunkedGrid<Tile>> tiles = std::make_shared<ChunkedGrid<Tile>>();
 
   std::vector<std::unique_ptr<Enemy>> enemies;
   std::vector<std::unique_ptr<Hazard>> hazards;
   std::vector<std::unique_ptr<Actor>> actors;
   std::vector<std::unique_ptr<Particle>> particles;
   std::vector<MovingPlatform> moving_platforms;
+  std::vector<Supporter> supporters;
+  // Supporter handles by the tile row of their top, so that lookups don't scan the level
+  std::vector<std::vector<int>> supporter_rows;
+  int max_supporter_height = 0;
   std::vector<Entrance> entrances;
   std::unique_ptr<Exit> exit;
   bool show_player_controls = false;
@@ -73,7 +109,12 @@ struct Level
   std::bitset<3> lever_on = {0};
   geometry::Position dv;
   std::vector<geometry::Rectangle> falling_rocks_areas = {};
-  int falling_rock_ticks = 0;
+  // Rocks don't fall again before this tick
+  unsigned falling_rocks_tick = 0;
+  // Game ticks since the level was loaded
+  unsigned tick = 0;
+  // Sleeping enemies and hazards by wake tick; the wheel's time only passes when they are updated
+  TimerWheel<Actor*> sleepers;
   int gravity = GRAVITY;
   int recoil = 0;
   bool no_air = false;
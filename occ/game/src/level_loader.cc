@@ -2,6 +2,7 @@
 
 #include <cstdio>
 #include <fstream>
+#include <random>
 #include <unordered_set>
 #include <utility>
 
@@ -60,10 +61,6 @@ constexpr int levelRows[] = {
   24,
   24,
 };
-// Some levels have a missing first row (those with levelRows 23)
-// Fill in the first row with block tiles
-const std::string extraRow = "5gggggggggggggggggggggggggggggggggggggg5";
-const std::string emptyRow(40, ' ');
 const std::tuple<Sprite, geometry::Size, int> levelBGs[] = {
   // intro
   {Sprite::SPRITE_STARS_1, {6, 1}, 0},
@@ -234,6 +231,8 @@ std::unique_ptr<Level> load(const ExeData& exe_data, const LevelId level_id, con
 
   auto level = std::make_unique<Level>();
   level->level_id = level_id;
+  // Not rand(), levels may be loaded on a background thread while the game runs
+  std::minstd_rand rng(std::random_device{}());
   // Render player control hints if player hasn't completed any level
   level->show_player_controls = !state.has_completed_any_level();
   if (level->is_space())
@@ -242,10 +241,12 @@ std::unique_ptr<Level> load(const ExeData& exe_data, const LevelId level_id, con
   }
 
   // Read the tile ids of the level
-  level->width = 0;
+  // All rows have the length of the first one
+  level->width = *ptr;
   if (levelRows[l] == 23)
   {
-    // Some levels have a missing first row
+    // Some levels have a missing first row, fill it in with block tiles
+    const std::string extraRow = "5" + std::string(level->width - 2, 'g') + "5";
     LOG_DEBUG("%s", extraRow.c_str());
     for (char c : extraRow)
     {
@@ -257,6 +258,7 @@ std::unique_ptr<Level> load(const ExeData& exe_data, const LevelId level_id, con
   {
     // Space levels have a garbage first row, and we want to add extra rows
     // above and below
+    const std::string emptyRow(level->width, ' ');
     const int extraRows = 24 - levelRows[l];
     for (int i = 0; i < extraRows / 2 + 1; i++)
     {
@@ -271,10 +273,6 @@ std::unique_ptr<Level> load(const ExeData& exe_data, const LevelId level_id, con
   for (int row = 0; row < levelRows[l]; row++)
   {
     const int len = *ptr;
-    if (level->width == 0)
-    {
-      level->width = len;
-    }
     ptr++;
     const auto row_str = std::string(ptr).substr(0, len);
     LOG_DEBUG("%s", row_str.c_str());
@@ -292,6 +290,7 @@ std::unique_ptr<Level> load(const ExeData& exe_data, const LevelId level_id, con
   // Insert extra rows below for space levels
   if (level->is_space())
   {
+    const std::string emptyRow(level->width, ' ');
     const int extraRows = 24 - levelRows[l];
     for (int i = 0; i < (extraRows + 1) / 2; i++)
     {
@@ -313,6 +312,8 @@ std::unique_ptr<Level> load(const ExeData& exe_data, const LevelId level_id, con
     const int extraRows = 24 - levelRows[l];
     level->height += extraRows;
   }
+  level->tiles = std::make_shared<ChunkedGrid<Tile>>(level->width, level->height, Tile::INVALID);
+  level->bgs = std::make_shared<ChunkedGrid<int>>(level->width, level->height, -1);
   const auto background = levelBGs[static_cast<int>(level_id)];
   const auto block_sprite = blockColors[static_cast<int>(level_id)];
   const bool block_solid = block_sprite != Sprite::SPRITE_BLOCK_GREEN_NW;
@@ -343,11 +344,11 @@ std::unique_ptr<Level> load(const ExeData& exe_data, const LevelId level_id, con
     int bg = static_cast<int>(std::get<0>(background));
     if (is_stars_row)
     {
-      bg = static_cast<int>(STARS[rand() % STARS.size()]);
+      bg = static_cast<int>(STARS[rng() % STARS.size()]);
     }
     else if (is_horizon_row)
     {
-      bg = static_cast<int>(HORIZON[rand() % HORIZON.size()]);
+      bg = static_cast<int>(HORIZON[rng() % HORIZON.size()]);
     }
     else
     {
@@ -1282,13 +1283,13 @@ std::unique_ptr<Level> load(const ExeData& exe_data, const LevelId level_id, con
             if (is_horizon_row || (x == 0 && level->tile_ids[i + 1] == 'Z'))
             {
               // Random horizon tile
-              bg = static_cast<int>(HORIZON[rand() % HORIZON.size()]);
+              bg = static_cast<int>(HORIZON[rng() % HORIZON.size()]);
               is_horizon_row = true;
             }
             else
             {
               // Random star tile
-              bg = static_cast<int>(STARS[rand() % STARS.size()]);
+              bg = static_cast<int>(STARS[rng() % STARS.size()]);
               is_stars_row = true;
             }
             break;
@@ -1859,8 +1860,8 @@ std::unique_ptr<Level> load(const ExeData& exe_data, const LevelId level_id, con
     {
       tile = Tile(sprite, sprite_count, flags);
     }
-    level->tiles.push_back(tile);
-    level->bgs.push_back(bg);
+    level->tiles->set(x, y, tile);
+    level->bgs->set(x, y, bg);
   }
   if (falling_rocks)
   {
@@ -1868,10 +1869,10 @@ std::unique_ptr<Level> load(const ExeData& exe_data, const LevelId level_id, con
     // Scan level left-to-right and add rectangles
     // Add area as long as there's a non-solid block in the column
     geometry::Rectangle r{{0, 8 * 16}, {0, 15 * 16}};
-    for (int x = 0; x < 40; x++)
+    for (int x = 0; x < level->width; x++)
     {
       bool has_non_solid_block = false;
-      for (int y = 8; y < 24; y++)
+      for (int y = 8; y < level->height; y++)
       {
         if (!level->collides_solid({x * 16, y * 16}, {16, 16}))
         {
@@ -1901,6 +1902,26 @@ std::unique_ptr<Level> load(const ExeData& exe_data, const LevelId level_id, con
     }
   }
 
+  // Register what can be stood on; actors that become solid on top later register themselves
+  for (auto& platform : level->moving_platforms)
+  {
+    platform.supporter = level->add_supporter({platform.position, {16, 16}}, true);
+  }
+  for (const auto& actor : level->actors)
+  {
+    if (actor->is_solid_top(*level))
+    {
+      level->add_supporter(actor->rect(), false);
+    }
+  }
+  for (const auto& hazard : level->hazards)
+  {
+    if (hazard->is_solid_top(*level))
+    {
+      level->add_supporter(hazard->rect(), false);
+    }
+  }
+
   return level;
 }
 }
@@ -0,0 +1,59 @@
+#include "level_prefetcher.h"
+
+#include <utility>
+
+#include "level.h"
+#include "level_loader.h"
+#include "logger.h"
+
+LevelPrefetcher::LevelPrefetcher() : load_(LevelLoader::load) {}
+
+void LevelPrefetcher::prefetch(const ExeData& exe_data, const LevelId level_id, const PlayerState& state)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (loading_)
+  {
+    // Asked again once the current load has finished
+    return;
+  }
+  if (done_ && is_same(level_id, state))
+  {
+    return;
+  }
+
+  LOG_DEBUG("Prefetching level %d", static_cast<int>(level_id));
+  level_id_ = level_id;
+  levels_completed_ = state.levels_completed;
+  loading_ = true;
+  done_ = false;
+  level_.reset();
+  if (!thread_pool_)
+  {
+    thread_pool_ = std::make_unique<ThreadPool>(1);
+  }
+  thread_pool_->post(
+    [this, &exe_data, level_id, state]
+    {
+      auto level = load_(exe_data, level_id, state);
+      std::lock_guard<std::mutex> lock(mutex_);
+      level_ = std::move(level);
+      loading_ = false;
+      done_ = true;
+    });
+}
+
+std::unique_ptr<Level> LevelPrefetcher::take(const LevelId level_id, const PlayerState& state)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if ((!loading_ && !done_) || !is_same(level_id, state))
+    {
+      return nullptr;
+    }
+  }
+  // Only this thread starts loads, so the one in progress is the wanted level
+  thread_pool_->wait_idle();
+  std::lock_guard<std::mutex> lock(mutex_);
+  done_ = false;
+  return std::move(level_);
+}
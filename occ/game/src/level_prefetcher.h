@@ -0,0 +1,52 @@
+#pragma once
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "exe_data.h"
+#include "level_id.h"
+#include "player_state.h"
+#include "thread_pool.h"
+
+struct Level;
+
+/// Loads a level on a background thread before the player enters it, so that entering doesn't wait for the loader
+/// One level is loaded at a time
+class LevelPrefetcher
+{
+ public:
+  using Load = std::function<std::unique_ptr<Level>(const ExeData& exe_data, const LevelId level_id, const PlayerState& state)>;
+
+  // Loads levels with LevelLoader::load
+  LevelPrefetcher();
+  // Loads levels with load instead, e.g. to run without the game data
+  explicit LevelPrefetcher(Load load) : load_(std::move(load)) {}
+
+  // Starts loading the level, unless it is already loaded or loading for the same state
+  // exe_data must outlive the prefetcher
+  void prefetch(const ExeData& exe_data, const LevelId level_id, const PlayerState& state);
+  // The prefetched level if it was loaded for the same state, waiting for it if it is still loading
+  // Returns null if the level wasn't prefetched or failed to load
+  std::unique_ptr<Level> take(const LevelId level_id, const PlayerState& state);
+
+ private:
+  // Levels only depend on which levels the player has completed
+  bool is_same(const LevelId level_id, const PlayerState& state) const
+  {
+    return level_id == level_id_ && state.levels_completed == levels_completed_;
+  }
+
+  Load load_;
+  std::mutex mutex_;
+  LevelId level_id_ = LevelId::INTRO;
+  std::array<bool, 20> levels_completed_ = {};
+  bool loading_ = false;
+  // Set when the load has finished, even if it failed
+  bool done_ = false;
+  std::unique_ptr<Level> level_;
+  // Created on the first prefetch; last so that the worker is joined first
+  std::unique_ptr<ThreadPool> thread_pool_;
+};
@@ -36,8 +36,3 @@ void MovingPlatform::update(const Level& level)
   ticks_++;
 }
 
-
-Vector<int> MovingPlatform::get_velocity([[maybe_unused]] const Level& level) const
-{
-  return is_moving ? velocity : Vector<int>(0, 0);
-}
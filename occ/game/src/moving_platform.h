@@ -13,9 +13,12 @@ struct MovingPlatform
   void update(const Level& level);
 
   geometry::Position position;
+  // Position before the last update, used to interpolate rendering between ticks
+  geometry::Position prev_position;
   geometry::Size collide_size = geometry::Size(16, 32);
+  // Handle in Level::supporters
+  int supporter = -1;
 
-  Vector<int> get_velocity(const Level& level) const;
   bool is_moving = false;
 
  private:
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "actor.h"
+#include "geometry.h"
+#include "thread_pool.h"
+
+struct Level;
+
+// Lets all actors think, split into one chunk per thread on pool if given, otherwise on the calling thread
+// Actor i thought if thought[i], and then intents[i] must be applied before the next think
+// Each actor only writes its own entries, so the result is the same either way
+template <typename T>
+void think_actors(const std::vector<std::unique_ptr<T>>& actors,
+                  const geometry::Rectangle& player_rect,
+                  const Level& level,
+                  std::vector<ActorIntents>& intents,
+                  std::vector<std::uint8_t>& thought,
+                  ThreadPool* pool)
+{
+  const auto num_actors = actors.size();
+  if (intents.size() < num_actors)
+  {
+    intents.resize(num_actors);
+  }
+  thought.resize(num_actors);
+  const auto think_range = [&](const size_t begin, const size_t end)
+  {
+    for (auto i = begin; i < end; i++)
+    {
+      // Sleeping actors neither think nor get updated
+      thought[i] = !actors[i]->asleep && actors[i]->think(player_rect, level, intents[i]);
+    }
+  };
+
+  if (!pool)
+  {
+    think_range(0, num_actors);
+    return;
+  }
+  const auto chunk_size = (num_actors + pool->size() - 1) / pool->size();
+  for (size_t begin = 0; begin < num_actors; begin += chunk_size)
+  {
+    pool->post([&think_range, begin, end = std::min(begin + chunk_size, num_actors)] { think_range(begin, end); });
+  }
+  pool->wait_idle();
+}
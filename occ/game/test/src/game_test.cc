@@ -1,4 +1,407 @@
-int main()
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <vector>
+
+#include "actor.h"
+#include "enemy.h"
+#include "entrance.h"
+#include "exe_data.h"
+#include "game_impl.h"
+#include "geometry.h"
+#include "level.h"
+#include "level_prefetcher.h"
+#include "moving_platform.h"
+#include "player.h"
+#include "player_state.h"
+#include "sound.h"
+#include "thread_pool.h"
+#include "think.h"
+#include "tile.h"
+
+namespace
 {
-  return 0;
+
+class RecordingSoundManager : public AbstractSoundManager
+{
+ public:
+  void play_sound(const SoundType sound) const override { sounds.push_back(sound); }
+
+  mutable std::vector<SoundType> sounds;
+};
+
+std::unique_ptr<Level> make_empty_level(const int width, const int height)
+{
+  auto level = std::make_unique<Level>();
+  level->level_id = LevelId::LEVEL_1;
+  level->width = width;
+  level->height = height;
+  level->tiles = std::make_shared<ChunkedGrid<Tile>>(width, height, Tile::INVALID);
+  return level;
+}
+
+// Floors every four rows with walls at both ends, and walking, patrolling, pausing and shooting enemies on them
+std::unique_ptr<Level> make_crowded_level(const int num_enemies)
+{
+  auto level = make_empty_level(64, 32);
+  for (int y = 3; y < level->height; y += 4)
+  {
+    for (int x = 0; x < level->width; x++)
+    {
+      level->tiles->set(x, y, Tile(1, 1, TILE_SOLID));
+    }
+    level->tiles->set(0, y - 1, Tile(1, 1, TILE_SOLID));
+    level->tiles->set(level->width - 1, y - 1, Tile(1, 1, TILE_SOLID));
+  }
+  for (int i = 0; i < num_enemies; i++)
+  {
+    const geometry::Position position{(1 + (i * 7) % (level->width - 2)) * 16, (2 + 4 * (i % 8)) * 16};
+    switch (i % 5)
+    {
+      case 0:
+        level->enemies.push_back(std::make_unique<Bigfoot>(position + geometry::Position(0, 16)));
+        break;
+      case 1:
+        level->enemies.push_back(std::make_unique<MineCart>(position));
+        break;
+      case 2:
+        level->enemies.push_back(std::make_unique<Snake>(position));
+        break;
+      case 3:
+        level->enemies.push_back(std::make_unique<Ostrich>(position));
+        break;
+      default:
+        level->enemies.push_back(std::make_unique<Rockman>(position));
+        break;
+    }
+  }
+  return level;
+}
+
+// Runs the enemies' think and apply phases like GameImpl does, and returns their state after each tick
+std::vector<std::vector<int>> run_enemies(Level& level, RecordingSoundManager& sound_manager, ThreadPool* pool, const int ticks)
+{
+  const geometry::Rectangle player_rect{level.width * 8, 14 * 16, 12, 16};
+  std::vector<ActorIntents> intents;
+  std::vector<std::uint8_t> thought;
+  std::vector<std::vector<int>> states;
+  for (int tick = 0; tick < ticks; tick++)
+  {
+    level.advance_sleepers();
+    think_actors(level.enemies, player_rect, level, intents, thought, pool);
+    for (size_t i = 0; i < thought.size(); i++)
+    {
+      if (thought[i])
+      {
+        intents[i].apply(*level.enemies[i], sound_manager, level);
+      }
+      else if (!level.enemies[i]->asleep)
+      {
+        level.enemies[i]->update(sound_manager, player_rect, level);
+      }
+    }
+
+    auto& state = states.emplace_back();
+    for (const auto& enemy : level.enemies)
+    {
+      state.push_back(enemy->position.x());
+      state.push_back(enemy->position.y());
+      state.push_back(enemy->asleep);
+      state.push_back(enemy->get_sprites(level).front().sprite_id);
+    }
+    state.push_back(static_cast<int>(level.hazards.size()));
+  }
+  return states;
+}
+
+// Loads empty levels once released, failing if asked to, and counts the loads
+// The main level has open entrances to the first two levels
+class FakeLoader
+{
+ public:
+  LevelPrefetcher::Load load()
+  {
+    return [this](const ExeData&, const LevelId level_id, const PlayerState&) -> std::unique_ptr<Level>
+    {
+      num_loads++;
+      released_.wait();
+      if (fail)
+      {
+        return nullptr;
+      }
+      auto level = make_empty_level(10, 10);
+      level->level_id = level_id;
+      if (level_id == LevelId::MAIN_LEVEL)
+      {
+        num_main_level_loads++;
+        level->entrances.emplace_back(geometry::Position(32, 32), static_cast<int>(LevelId::LEVEL_1), EntranceState::OPEN);
+        level->entrances.emplace_back(geometry::Position(96, 32), static_cast<int>(LevelId::LEVEL_2), EntranceState::OPEN);
+        level->show_player_controls = true;
+      }
+      return level;
+    };
+  }
+
+  void release() { release_.set_value(); }
+
+  bool fail = false;
+  std::atomic<int> num_loads = 0;
+  std::atomic<int> num_main_level_loads = 0;
+
+ private:
+  std::promise<void> release_;
+  std::shared_future<void> released_ = release_.get_future().share();
+};
+
+EntranceState get_entrance_state(const Level& level, const LevelId level_id)
+{
+  const auto it =
+    std::find_if(level.entrances.begin(), level.entrances.end(), [&](const Entrance& e) { return e.level == static_cast<int>(level_id); });
+  return it->state;
+}
+
+// Enters the first level from the main level and returns the main level, which is now suspended
+const Level* enter_level_1(GameImpl& game, RecordingSoundManager& sound_manager, const ExeData& exe_data, const PlayerState& state)
+{
+  EXPECT_TRUE(game.init(sound_manager, exe_data, LevelId::MAIN_LEVEL, state, LevelId::INTRO));
+  const auto* main_level = &game.get_level();
+  EXPECT_TRUE(game.init(sound_manager, exe_data, LevelId::LEVEL_1, state, LevelId::MAIN_LEVEL));
+  EXPECT_EQ(LevelId::LEVEL_1, game.get_level().level_id);
+  return main_level;
+}
+
+}  // namespace
+
+TEST(Think, parallel_matches_serial)
+{
+  constexpr int num_enemies = 320;
+  constexpr int ticks = 200;
+
+  auto serial_level = make_crowded_level(num_enemies);
+  RecordingSoundManager serial_sounds;
+  const auto serial = run_enemies(*serial_level, serial_sounds, nullptr, ticks);
+
+  auto parallel_level = make_crowded_level(num_enemies);
+  RecordingSoundManager parallel_sounds;
+  ThreadPool pool(4);
+  const auto parallel = run_enemies(*parallel_level, parallel_sounds, &pool, ticks);
+
+  EXPECT_EQ(serial, parallel);
+  EXPECT_EQ(serial_sounds.sounds, parallel_sounds.sounds);
+
+  // The enemies did walk, sleep and shoot
+  EXPECT_NE(serial.front(), serial.back());
+  EXPECT_FALSE(serial_sounds.sounds.empty());
+  EXPECT_GT(serial.back().back(), 0);
+}
+
+TEST(Level, find_supporter)
+{
+  auto level = make_empty_level(10, 10);
+  EXPECT_EQ(-1, level->find_supporter({36, 32}, Player::size));
+
+  const int fixed = level->add_supporter({{32, 48}, {16, 16}}, false);
+  EXPECT_EQ(fixed, level->find_supporter({36, 32}, Player::size));
+  // Overlapping only by a pixel at either side
+  EXPECT_EQ(fixed, level->find_supporter({21, 32}, Player::size));
+  EXPECT_EQ(fixed, level->find_supporter({47, 32}, Player::size));
+  EXPECT_EQ(-1, level->find_supporter({20, 32}, Player::size));
+  EXPECT_EQ(-1, level->find_supporter({48, 32}, Player::size));
+  // Only right on top
+  EXPECT_EQ(-1, level->find_supporter({36, 31}, Player::size));
+  EXPECT_EQ(-1, level->find_supporter({36, 33}, Player::size));
+
+  // Moving platforms win over what they overlap, as they carry what stands on them
+  const int moving = level->add_supporter({{40, 48}, {16, 16}}, true);
+  EXPECT_EQ(moving, level->find_supporter({36, 32}, Player::size));
+  EXPECT_EQ(fixed, level->find_supporter({24, 32}, Player::size));
+
+  // Found in its new row after moving
+  level->move_supporter(moving, {40, 100});
+  EXPECT_EQ(fixed, level->find_supporter({36, 32}, Player::size));
+  EXPECT_EQ(moving, level->find_supporter({44, 84}, Player::size));
+  EXPECT_TRUE(level->player_on_platform({44, 85}, Player::size));
+}
+
+TEST(Level, riders_carried_across_rows)
+{
+  // A vertical platform going down to the floor and back up, with the player on it
+  auto level = make_empty_level(10, 10);
+  for (int x = 0; x < level->width; x++)
+  {
+    level->tiles->set(x, level->height - 1, Tile(1, 1, TILE_SOLID));
+  }
+  auto& platform = level->moving_platforms.emplace_back(geometry::Position(32, 16), false, false);
+  platform.supporter = level->add_supporter({platform.position, {16, 16}}, true);
+  Player player;
+  player.position = {34, 0};
+
+  int lowest_row = 0;
+  for (int tick = 0; tick < 100; tick++)
+  {
+    level->update_moving_platforms(player);
+    ASSERT_EQ(platform.supporter, player.support) << "tick " << tick;
+    ASSERT_EQ(platform.position.y(), player.position.y() + Player::size.y()) << "tick " << tick;
+    ASSERT_EQ(34, player.position.x());
+    ASSERT_EQ(platform.supporter, level->find_supporter(player.position, Player::size)) << "tick " << tick;
+    lowest_row = std::max(lowest_row, level->supporter_row(platform.position.y()));
+  }
+  EXPECT_EQ(level->height - 2, lowest_row);
+  EXPECT_LT(platform.position.y(), 100);
+}
+
+TEST(LevelPrefetcher, take_only_for_same_state)
+{
+  const ExeData exe_data;
+  FakeLoader loader;
+  loader.release();
+  LevelPrefetcher prefetcher(loader.load());
+  PlayerState state(1);
+  EXPECT_EQ(nullptr, prefetcher.take(LevelId::MAIN_LEVEL, state));
+
+  prefetcher.prefetch(exe_data, LevelId::MAIN_LEVEL, state);
+  EXPECT_EQ(nullptr, prefetcher.take(LevelId::LEVEL_1, state));
+  auto other_state = state;
+  other_state.levels_completed[static_cast<int>(LevelId::LEVEL_1)] = true;
+  EXPECT_EQ(nullptr, prefetcher.take(LevelId::MAIN_LEVEL, other_state));
+  // The score etc. don't matter
+  other_state = state;
+  other_state.score = 1000;
+  const auto level = prefetcher.take(LevelId::MAIN_LEVEL, other_state);
+  ASSERT_NE(nullptr, level);
+  EXPECT_EQ(LevelId::MAIN_LEVEL, level->level_id);
+  // Only taken once
+  EXPECT_EQ(nullptr, prefetcher.take(LevelId::MAIN_LEVEL, state));
+  EXPECT_EQ(1, loader.num_loads);
+}
+
+TEST(LevelPrefetcher, take_failed_load)
+{
+  const ExeData exe_data;
+  FakeLoader loader;
+  loader.fail = true;
+  loader.release();
+  LevelPrefetcher prefetcher(loader.load());
+  const PlayerState state(1);
+
+  prefetcher.prefetch(exe_data, LevelId::MAIN_LEVEL, state);
+  EXPECT_EQ(nullptr, prefetcher.take(LevelId::MAIN_LEVEL, state));
+  EXPECT_EQ(1, loader.num_loads);
+}
+
+TEST(LevelPrefetcher, prefetch_ignored_while_loading)
+{
+  const ExeData exe_data;
+  FakeLoader loader;
+  LevelPrefetcher prefetcher(loader.load());
+  const PlayerState state(1);
+
+  prefetcher.prefetch(exe_data, LevelId::MAIN_LEVEL, state);
+  prefetcher.prefetch(exe_data, LevelId::LEVEL_1, state);
+  loader.release();
+  EXPECT_EQ(nullptr, prefetcher.take(LevelId::LEVEL_1, state));
+  const auto level = prefetcher.take(LevelId::MAIN_LEVEL, state);
+  ASSERT_NE(nullptr, level);
+  EXPECT_EQ(LevelId::MAIN_LEVEL, level->level_id);
+  EXPECT_EQ(1, loader.num_loads);
+}
+
+TEST(LevelPrefetcher, take_waits_for_load)
+{
+  const ExeData exe_data;
+  FakeLoader loader;
+  LevelPrefetcher prefetcher(loader.load());
+  const PlayerState state(1);
+
+  prefetcher.prefetch(exe_data, LevelId::MAIN_LEVEL, state);
+  auto taken = std::async(std::launch::async, [&] { return prefetcher.take(LevelId::MAIN_LEVEL, state); });
+  EXPECT_EQ(std::future_status::timeout, taken.wait_for(std::chrono::milliseconds(50)));
+  loader.release();
+  const auto level = taken.get();
+  ASSERT_NE(nullptr, level);
+  EXPECT_EQ(LevelId::MAIN_LEVEL, level->level_id);
+}
+
+TEST(GameImpl, resume_main_level_after_completing)
+{
+  const ExeData exe_data;
+  RecordingSoundManager sound_manager;
+  FakeLoader loader;
+  loader.release();
+  GameImpl game(loader.load());
+  PlayerState state(1);
+  const auto* main_level = enter_level_1(game, sound_manager, exe_data, state);
+
+  state.levels_completed[static_cast<int>(LevelId::LEVEL_1)] = true;
+  ASSERT_TRUE(game.init(sound_manager, exe_data, LevelId::MAIN_LEVEL, state, LevelId::LEVEL_1));
+  EXPECT_EQ(main_level, &game.get_level());
+  EXPECT_EQ(1, loader.num_main_level_loads);
+  EXPECT_EQ(EntranceState::COMPLETE, get_entrance_state(game.get_level(), LevelId::LEVEL_1));
+  EXPECT_EQ(EntranceState::OPEN, get_entrance_state(game.get_level(), LevelId::LEVEL_2));
+  EXPECT_FALSE(game.get_level().show_player_controls);
+}
+
+TEST(GameImpl, resume_main_level_after_dying_or_quitting)
+{
+  const ExeData exe_data;
+  RecordingSoundManager sound_manager;
+  FakeLoader loader;
+  loader.release();
+  GameImpl game(loader.load());
+  const PlayerState state(1);
+  const auto* main_level = enter_level_1(game, sound_manager, exe_data, state);
+
+  // Dying restarts the level
+  ASSERT_TRUE(game.init(sound_manager, exe_data, LevelId::LEVEL_1, state, LevelId::LEVEL_1));
+  ASSERT_TRUE(game.init(sound_manager, exe_data, LevelId::MAIN_LEVEL, state, LevelId::LEVEL_1));
+  EXPECT_EQ(main_level, &game.get_level());
+  EXPECT_EQ(1, loader.num_main_level_loads);
+  EXPECT_EQ(EntranceState::OPEN, get_entrance_state(game.get_level(), LevelId::LEVEL_1));
+  EXPECT_EQ(EntranceState::OPEN, get_entrance_state(game.get_level(), LevelId::LEVEL_2));
+  EXPECT_TRUE(game.get_level().show_player_controls);
+}
+
+TEST(GameImpl, reload_main_level_for_other_levels_completed)
+{
+  const ExeData exe_data;
+  RecordingSoundManager sound_manager;
+  FakeLoader loader;
+  loader.release();
+  GameImpl game(loader.load());
+  PlayerState state(1);
+  enter_level_1(game, sound_manager, exe_data, state);
+
+  // E.g. another saved game, where a level other than the one just left was completed
+  state.levels_completed[static_cast<int>(LevelId::LEVEL_2)] = true;
+  ASSERT_TRUE(game.init(sound_manager, exe_data, LevelId::MAIN_LEVEL, state, LevelId::LEVEL_1));
+  EXPECT_EQ(LevelId::MAIN_LEVEL, game.get_level().level_id);
+  EXPECT_EQ(2, loader.num_main_level_loads);
+  EXPECT_TRUE(game.get_level().show_player_controls);
+}
+
+TEST(GameImpl, discard_main_level_on_intro_and_finale)
+{
+  const ExeData exe_data;
+  RecordingSoundManager sound_manager;
+  FakeLoader loader;
+  loader.release();
+  GameImpl game(loader.load());
+  const PlayerState state(1);
+
+  enter_level_1(game, sound_manager, exe_data, state);
+  ASSERT_TRUE(game.init(sound_manager, exe_data, LevelId::FINALE, state, LevelId::LEVEL_1));
+  ASSERT_TRUE(game.init(sound_manager, exe_data, LevelId::MAIN_LEVEL, state, LevelId::FINALE));
+  EXPECT_EQ(2, loader.num_main_level_loads);
+
+  enter_level_1(game, sound_manager, exe_data, state);
+  EXPECT_EQ(3, loader.num_main_level_loads);
+  // A new game, the intro prefetches the main level
+  ASSERT_TRUE(game.init(sound_manager, exe_data, LevelId::INTRO, state, LevelId::LEVEL_1));
+  ASSERT_TRUE(game.init(sound_manager, exe_data, LevelId::MAIN_LEVEL, state, LevelId::INTRO));
+  EXPECT_EQ(4, loader.num_main_level_loads);
 }
@@ -31,14 +31,14 @@ int main()
     LOG_CRITICAL("Could not create Window");
     return 1;
   }
-  ImageManager image_manager;
-  if (!image_manager.load_images(*window))
+  ImageManager image_manager(*window);
+  int image = (int)IMAGE_APOGEE;
+  auto surfaces = image_manager.get_images(episode, (CCImage)image);
+  if (surfaces.empty())
   {
     LOG_CRITICAL("Could not load images");
     return 1;
   }
-  int image = (int)IMAGE_APOGEE;
-  auto surfaces = image_manager.get_images(episode, (CCImage)image);
   int index = 0;
   window->set_size(surfaces[index]->size());
   auto event = Event::create();
@@ -0,0 +1,113 @@
+#include "asset_loader.h"
+
+#include "logger.h"
+#include "thread_pool.h"
+
+AssetLoader::~AssetLoader()
+{
+  // Decode jobs refer to this, so let them finish; pending uploads are dropped
+  std::unique_lock<std::mutex> lock(mutex_);
+  decoded_.wait(lock, [this] { return decoding_ == 0; });
+}
+
+void AssetLoader::add(const std::string& name, Decode decode)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    status_[name] = Status::DECODING;
+    decoding_++;
+  }
+  thread_pool_.post(
+    [this, name, decode = std::move(decode)]
+    {
+      auto upload = decode();
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        decoding_--;
+        if (upload)
+        {
+          status_[name] = Status::DECODED;
+          uploads_.emplace_back(name, std::move(upload));
+        }
+        else
+        {
+          LOG_CRITICAL("Could not decode %s", name.c_str());
+          status_[name] = Status::FAILED;
+          failed_ = true;
+        }
+        // Under the lock: once decoding_ is 0 the destructor may return and destroy decoded_
+        decoded_.notify_all();
+      }
+    });
+}
+
+bool AssetLoader::poll()
+{
+  while (true)
+  {
+    std::pair<std::string, Upload> upload;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (uploads_.empty())
+      {
+        return !failed_;
+      }
+      upload = std::move(uploads_.front());
+      uploads_.pop_front();
+    }
+    // Upload without holding the lock so that workers are not blocked
+    const bool ok = upload.second();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (ok)
+    {
+      LOG_DEBUG("Loaded %s", upload.first.c_str());
+      status_[upload.first] = Status::LOADED;
+    }
+    else
+    {
+      LOG_CRITICAL("Could not load %s", upload.first.c_str());
+      status_[upload.first] = Status::FAILED;
+      failed_ = true;
+    }
+  }
+}
+
+bool AssetLoader::wait(const std::string& name)
+{
+  while (true)
+  {
+    poll();
+    std::unique_lock<std::mutex> lock(mutex_);
+    const auto it = status_.find(name);
+    if (it == status_.end())
+    {
+      LOG_ERROR("Unknown asset %s", name.c_str());
+      return false;
+    }
+    if (it->second == Status::LOADED || it->second == Status::FAILED)
+    {
+      return it->second == Status::LOADED;
+    }
+    decoded_.wait(lock, [this, &it] { return !uploads_.empty() || it->second == Status::FAILED; });
+  }
+}
+
+bool AssetLoader::wait_all()
+{
+  while (true)
+  {
+    poll();
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (decoding_ == 0 && uploads_.empty())
+    {
+      return !failed_;
+    }
+    decoded_.wait(lock, [this] { return !uploads_.empty() || decoding_ == 0; });
+  }
+}
+
+bool AssetLoader::done() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return decoding_ == 0 && uploads_.empty();
+}
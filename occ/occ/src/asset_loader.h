@@ -0,0 +1,52 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+class ThreadPool;
+
+/// Loads assets in the background
+/// Each asset is decoded on a worker thread, and the resulting upload step (e.g. creating textures)
+/// is run on the main thread by poll() or wait()
+class AssetLoader
+{
+ public:
+  // Runs on the main thread; returns false on failure
+  using Upload = std::function<bool()>;
+  // Runs on a worker thread; returns the upload step, or an empty function on failure
+  using Decode = std::function<Upload()>;
+
+  explicit AssetLoader(ThreadPool& thread_pool) : thread_pool_(thread_pool) {}
+  ~AssetLoader();
+
+  void add(const std::string& name, Decode decode);
+  // Runs the upload steps of the assets decoded so far; returns false if any asset failed
+  bool poll();
+  // Blocks until the asset has been decoded and uploaded; returns false if it failed
+  bool wait(const std::string& name);
+  // Blocks until all assets have been loaded; returns false if any asset failed
+  bool wait_all();
+  bool done() const;
+
+ private:
+  enum class Status
+  {
+    DECODING,
+    DECODED,
+    LOADED,
+    FAILED,
+  };
+
+  ThreadPool& thread_pool_;
+  mutable std::mutex mutex_;
+  std::condition_variable decoded_;
+  std::unordered_map<std::string, Status> status_;
+  std::deque<std::pair<std::string, Upload>> uploads_;
+  unsigned decoding_ = 0;
+  bool failed_ = false;
+};
@@ -0,0 +1,108 @@
+#include "draw_list.h"
+
+#include <algorithm>
+#include <array>
+
+std::uint64_t DrawList::make_key(Layer layer, int band, int texture, int palette, std::uint32_t depth)
+{
+  // layer: 8 bits, band: 16 bits, texture: 12 bits, palette: 8 bits, depth: 20 bits
+  // Textures that share the low bits only lose some batching: they are still drawn in the order they were added
+  return (static_cast<std::uint64_t>(layer) << 56) | (static_cast<std::uint64_t>(band & 0xffff) << 40) |
+    (static_cast<std::uint64_t>(texture & 0xfff) << 28) | (static_cast<std::uint64_t>(palette & 0xff) << 20) | (depth & 0xfffff);
+}
+
+void DrawList::clear()
+{
+  commands_.clear();
+  texture_palettes_.clear();
+  keys_.clear();
+  for (auto& band : bands_)
+  {
+    band.index = 0;
+    band.commands.clear();
+  }
+}
+
+void DrawList::add_sprite(Layer layer,
+                          int sprite,
+                          const geometry::Position& position,
+                          const geometry::Position& camera_position,
+                          const geometry::Rectangle& dest,
+                          const Color color,
+                          int palette)
+{
+  Command command;
+  command.sprite = sprite;
+  command.position = position;
+  command.camera_position = camera_position;
+  command.dest = dest;
+  command.palette = palette;
+  command.color = color;
+  add(layer, TEXTURE_SPRITES, palette, command);
+}
+
+void DrawList::add_surface(Layer layer, int texture, const Surface& surface, const geometry::Rectangle& source, const geometry::Rectangle& dest)
+{
+  Command command;
+  command.surface = &surface;
+  command.source = source;
+  command.dest = dest;
+  add(layer, texture, 0, command);
+}
+
+void DrawList::add(Layer layer, int texture, int palette, Command command)
+{
+  const auto index = static_cast<std::uint32_t>(commands_.size());
+  const auto texture_palette = (static_cast<std::uint32_t>(texture & 0xfff) << 8) | (palette & 0xff);
+  auto& band = bands_[static_cast<int>(layer)];
+  const bool overlaps = std::any_of(band.commands.begin(),
+                                    band.commands.end(),
+                                    [&](const std::uint32_t other)
+                                    {
+                                      return texture_palettes_[other] != texture_palette &&
+                                        geometry::isColliding(commands_[other].dest, command.dest);
+                                    });
+  if (overlaps || band.commands.size() >= MAX_BAND_SIZE)
+  {
+    band.index++;
+    band.commands.clear();
+  }
+  band.commands.push_back(index);
+  keys_.emplace_back(make_key(layer, band.index, texture, palette, index), index);
+  commands_.push_back(std::move(command));
+  texture_palettes_.push_back(texture_palette);
+}
+
+void DrawList::sort()
+{
+  if (keys_.size() < 2)
+  {
+    return;
+  }
+  scratch_.resize(keys_.size());
+  for (int shift = 0; shift < 64; shift += 8)
+  {
+    std::array<size_t, 256> offsets = {};
+    for (const auto& key : keys_)
+    {
+      offsets[(key.first >> shift) & 0xff]++;
+    }
+    // All keys have the same byte here, nothing to do
+    if (offsets[(keys_.front().first >> shift) & 0xff] == keys_.size())
+    {
+      continue;
+    }
+    size_t sum = 0;
+    for (auto& offset : offsets)
+    {
+      const auto count = offset;
+      offset = sum;
+      sum += count;
+    }
+    for (const auto& key : keys_)
+    {
+      scratch_[offsets[(key.first >> shift) & 0xff]++] = key;
+    }
+    keys_.swap(scratch_);
+  }
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "geometry.h"
+#include "graphics.h"
+
+/// Draw commands for one frame, submitted in sort key order
+/// The 64-bit key orders by layer, then band, then texture and palette so that the sprite batcher gets long runs of the
+/// same texture, and last by the order the commands were added
+/// A command that overlaps an earlier command of another texture or palette in the same layer starts a new band, so
+/// commands are only reordered where it doesn't change what ends up on screen
+class DrawList
+{
+ public:
+  enum class Layer : std::uint8_t
+  {
+    BACKGROUND,
+    BACK_TILES,
+    BACK_OBJECTS,
+    ENEMIES,
+    PLAYER,
+    FRONT_TILES,
+    FRONT_OBJECTS,
+  };
+
+  // Texture ids used in the sort key; surfaces other than the sprite sheet use SURFACE + their own index
+  static constexpr int TEXTURE_SPRITES = 0;
+  static constexpr int TEXTURE_SURFACE = 1;
+
+  struct Command
+  {
+    // Sprite sheet tile, or part of a surface if surface is set
+    int sprite = -1;
+    geometry::Position position;
+    geometry::Position camera_position;
+    int palette = 0;
+    Color color = {0xff, 0xff, 0xff};
+    const Surface* surface = nullptr;
+    geometry::Rectangle source;
+    // Where the command draws on screen
+    geometry::Rectangle dest;
+  };
+
+  static std::uint64_t make_key(Layer layer, int band, int texture, int palette, std::uint32_t depth);
+
+  void clear();
+  // dest is the part of the screen the sprite covers
+  void add_sprite(Layer layer,
+                  int sprite,
+                  const geometry::Position& position,
+                  const geometry::Position& camera_position,
+                  const geometry::Rectangle& dest,
+                  const Color color,
+                  int palette);
+  void add_surface(Layer layer, int texture, const Surface& surface, const geometry::Rectangle& source, const geometry::Rectangle& dest);
+
+  // Sorts the commands by key with an LSD radix sort, skipping bytes that are the same in all keys
+  void sort();
+
+  size_t size() const { return keys_.size(); }
+  // i-th command in key order, valid after sort()
+  const Command& operator[](size_t i) const { return commands_[keys_[i].second]; }
+
+ private:
+  static constexpr int NUM_LAYERS = static_cast<int>(Layer::FRONT_OBJECTS) + 1;
+  // Bounds the overlap checks per command
+  static constexpr size_t MAX_BAND_SIZE = 256;
+
+  void add(Layer layer, int texture, int palette, Command command);
+
+  struct Band
+  {
+    int index = 0;
+    // Commands in the current band of the layer
+    std::vector<std::uint32_t> commands;
+  };
+
+  std::vector<Command> commands_;
+  std::vector<std::uint32_t> texture_palettes_;
+  std::array<Band, NUM_LAYERS> bands_;
+  std::vector<std::pair<std::uint64_t, std::uint32_t>> keys_;
+  std::vector<std::pair<std::uint64_t, std::uint32_t>> scratch_;
+};
@@ -1,9 +1,16 @@
 #include "game_renderer.h"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <utility>
+
 #include "constants.h"
 #include "game.h"
 #include "graphics.h"
 #include "level.h"
+#include "logger.h"
 #include "misc.h"
 #include "occ_math.h"
 #include "player.h"
@@ -23,14 +30,17 @@ GameRenderer::GameRenderer(Game* game, SpriteManager* sprite_manager, Surface* g
                              (game_->get_tile_height() * 16) - CAMERA_SIZE.y()),
                  CAMERA_SIZE.x(),
                  CAMERA_SIZE.y()),
+    prev_camera_position_(game_camera_.position),
     game_tick_(0u),
     game_tick_diff_(0u),
     debug_(false)
 {
+  publish_snapshot();
 }
 
 void GameRenderer::update(unsigned game_tick)
 {
+  prev_camera_position_ = game_camera_.position;
   game_tick_diff_ = game_tick - game_tick_;
   game_tick_ = game_tick;
 
@@ -75,72 +85,308 @@ void GameRenderer::update(unsigned game_tick)
                                                            0,
                                                            (game_->get_tile_height() * 16) - CAMERA_SIZE.y()));
   }
+
+  publish_snapshot();
 }
 
-void GameRenderer::render_game(unsigned game_tick) const
+void GameRenderer::publish_snapshot()
 {
+  const auto& level = game_->get_level();
+  auto& snapshot = snapshots_.write_buffer();
+  snapshot.game_tick = game_tick_;
+  snapshot.level.level_id = level.level_id;
+  snapshot.level.width = level.width;
+  snapshot.level.height = level.height;
+  snapshot.level.player_spawn = level.player_spawn;
+  snapshot.level.show_player_controls = level.show_player_controls;
+  snapshot.level.space = level.is_space();
+  snapshot.level.recoil = level.recoil;
+  snapshot.level.tiles = level.tiles;
+  snapshot.level.bgs = level.bgs;
+  snapshot.switch_flags = level.switch_flags;
+  snapshot.gravity = level.gravity;
+  snapshot.has_key = level.has_key;
+  snapshot.camera = game_camera_;
+  snapshot.prev_camera_position = prev_camera_position_;
+  snapshot.game_complete_ticks = game_complete_ticks_;
+  snapshot.player = game_->get_player();
+  // Assigning reuses the storage of the snapshot this buffer held before
+  snapshot.objects = game_->get_objects();
+  snapshot.score = game_->get_score();
+  snapshot.num_ammo = game_->get_num_ammo();
+
+  // Only enemies near the camera are kept, the margin covers the camera moving back by up to a tick when interpolated
+  snapshot.enemy_sprites.clear();
+  snapshot.debug_rectangles.clear();
+  const geometry::Rectangle near_camera{game_camera_.position - geometry::Position(2 * SPRITE_W, 2 * SPRITE_H),
+                                        game_camera_.size + geometry::Size(4 * SPRITE_W, 4 * SPRITE_H)};
+  for (const auto& enemy : level.enemies)
+  {
+    if (geometry::isColliding(enemy->rect(), near_camera))
+    {
+      const auto motion = enemy->position - enemy->prev_position;
+      for (const auto& sprite_pos : enemy->get_sprites(level))
+      {
+        snapshot.enemy_sprites.push_back({sprite_pos.sprite_id, sprite_pos.position, sprite_pos.bright, motion});
+      }
+      if (debug_)
+      {
+        snapshot.debug_rectangles.emplace_back(enemy->rect(), Color{255, 0, 0});
+      }
+    }
+    if (debug_)
+    {
+      for (const auto& r : enemy->get_detection_rects(level))
+      {
+        snapshot.debug_rectangles.emplace_back(r, Color{255, 255, 0});
+      }
+    }
+  }
+  if (debug_)
+  {
+    for (const auto& hazard : level.hazards)
+    {
+      snapshot.debug_rectangles.emplace_back(hazard->rect(), Color{255, 128, 0});
+      for (const auto& r : hazard->get_detection_rects(level))
+      {
+        snapshot.debug_rectangles.emplace_back(r, Color{255, 255, 0});
+      }
+    }
+    // Falling rocks detection rects
+    for (const auto& r : level.falling_rocks_areas)
+    {
+      snapshot.debug_rectangles.emplace_back(r, Color{255, 0, 255});
+    }
+  }
+
+  snapshots_.publish();
+}
+
+void GameRenderer::render_game(const float alpha) const
+{
+  snapshot_ = &snapshots_.read();
+  alpha_ = alpha;
+  const auto& camera = snapshot_->camera;
+  render_camera_ = {camera.position + interpolation_offset(camera.position - snapshot_->prev_camera_position), camera.size};
+
   window_.set_render_target(game_surface_);
   // Clear game surface (background now)
   window_.fill_rect(geometry::Rectangle(0, 0, CAMERA_SIZE), {0, 0, 0});
+  draw_list_.clear();
+  debug_rectangles_.clear();
+  layer_ = DrawList::Layer::BACKGROUND;
   render_background();
+  update_visible_objects();
+  layer_ = DrawList::Layer::BACK_TILES;
   render_tiles(false);
   if (debug_)
   {
     // Player spawn
-    const geometry::Rectangle dest_rect{game_->get_level().player_spawn - game_camera_.position, {SPRITE_W, SPRITE_H}};
-    window_.render_rectangle(dest_rect, {0, 255, 0});
+    const geometry::Rectangle dest_rect{snapshot_->level.player_spawn - render_camera_.position, {SPRITE_W, SPRITE_H}};
+    render_debug_rectangle(dest_rect, {0, 255, 0});
   }
+  layer_ = DrawList::Layer::BACK_OBJECTS;
   render_objects(false);
-  render_enemies(game_tick);
+  layer_ = DrawList::Layer::ENEMIES;
+  render_enemies();
+  layer_ = DrawList::Layer::PLAYER;
   render_player();
+  layer_ = DrawList::Layer::FRONT_TILES;
   render_tiles(true);
+  layer_ = DrawList::Layer::FRONT_OBJECTS;
   render_objects(true);
+  submit_draw_list();
+  for (const auto& [rect, color] : debug_rectangles_)
+  {
+    window_.render_rectangle(rect, color);
+  }
   render_complete_border();
   render_statusbar();
   window_.set_render_target(nullptr);
 }
 
+namespace
+{
+// Background tiles are sorted into layers by parallax, furthest first:
+// - stars: in main level they are infinite distance away, but in space levels they
+//   are drawn with random offsets, i.e. one layer per factor 0, 0.1, ..., 0.5
+// - horizon: infinite horizontal parallax
+// - horizon lamps/mountains: horizontal parallax
+// - other background tiles: no parallax
+constexpr int NUM_STAR_LAYERS = 6;
+constexpr int HORIZON_LAYER = NUM_STAR_LAYERS;
+constexpr int HORIZON_FEATURES_LAYER = HORIZON_LAYER + 1;
+constexpr int TILES_LAYER = HORIZON_FEATURES_LAYER + 1;
+constexpr int NUM_BACKGROUND_LAYERS = TILES_LAYER + 1;
+
+// The sprite to draw in the given layer for the background tile, or -1 if the tile is not in that layer
+int background_layer_sprite(const RenderSnapshot::LevelState& level, const int tile_x, const int tile_y, const int layer)
+{
+  const auto sprite_id = level.get_bg(tile_x, tile_y);
+  if (sprite_id == -1)
+  {
+    return -1;
+  }
+  const bool is_star = sprite_id >= static_cast<int>(Sprite::SPRITE_STARS_1) && sprite_id <= static_cast<int>(Sprite::SPRITE_STARS_6);
+  const bool is_horizon =
+    (sprite_id >= static_cast<int>(Sprite::SPRITE_HORIZON_1) && sprite_id <= static_cast<int>(Sprite::SPRITE_HORIZON_4)) ||
+    sprite_id >= static_cast<int>(Sprite::SPRITE_HORIZON_LAMP);
+  if (is_star)
+  {
+    const int factor = level.is_space() ? (tile_x * 31 ^ tile_y * 7) % 6 : 0;
+    return layer == factor ? sprite_id : -1;
+  }
+  if (is_horizon)
+  {
+    if (layer == HORIZON_LAYER)
+    {
+      return static_cast<int>(Sprite::SPRITE_HORIZON);
+    }
+    return layer == HORIZON_FEATURES_LAYER ? sprite_id : -1;
+  }
+  return layer == TILES_LAYER ? sprite_id : -1;
+}
+
+// Chunks further than a chunk away from the view are freed
+bool is_near_view(const geometry::Rectangle& chunk_rect, const geometry::Rectangle& view)
+{
+  return geometry::isColliding(geometry::Rectangle(view.position - chunk_rect.size, view.size + chunk_rect.size + chunk_rect.size), chunk_rect);
+}
+}  // namespace
+
+void GameRenderer::update_background_layers() const
+{
+  const auto& level = snapshot_->level;
+  if (background_valid_ && background_level_id_ == level.level_id && background_remaster_ == sprite_manager_->remaster)
+  {
+    return;
+  }
+  background_valid_ = true;
+  background_level_id_ = level.level_id;
+  background_remaster_ = sprite_manager_->remaster;
+  background_chunks_w_ = (level.width + TILE_CHUNK_SIZE - 1) / TILE_CHUNK_SIZE;
+  const int num_chunks = background_chunks_w_ * ((level.height + TILE_CHUNK_SIZE - 1) / TILE_CHUNK_SIZE);
+  background_layers_.clear();
+  background_chunks_built_.clear();
+  for (int i = 0; i < NUM_BACKGROUND_LAYERS; i++)
+  {
+    Vector<double> parallax{1.0, 1.0};
+    if (i < NUM_STAR_LAYERS)
+    {
+      parallax = Vector<double>(i * 0.1, i * 0.1);
+    }
+    else if (i == HORIZON_LAYER)
+    {
+      parallax = Vector<double>(0.0, 1.0);
+    }
+    else if (i == HORIZON_FEATURES_LAYER)
+    {
+      parallax = Vector<double>(0.25, 1.0);
+    }
+    background_layers_.push_back({parallax, std::vector<std::unique_ptr<Surface>>(num_chunks), std::vector<bool>(num_chunks, false)});
+  }
+}
+
+void GameRenderer::render_background_chunk(int layer, int chunk) const
+{
+  const auto& level = snapshot_->level;
+  const geometry::Position chunk_tile{(chunk % background_chunks_w_) * TILE_CHUNK_SIZE, (chunk / background_chunks_w_) * TILE_CHUNK_SIZE};
+  const geometry::Position chunk_pos{chunk_tile.x() * SPRITE_W, chunk_tile.y() * SPRITE_H};
+  auto& surface = background_layers_[layer].chunks[chunk];
+  bool empty = true;
+  for (int tile_y = chunk_tile.y(); tile_y < chunk_tile.y() + TILE_CHUNK_SIZE; tile_y++)
+  {
+    for (int tile_x = chunk_tile.x(); tile_x < chunk_tile.x() + TILE_CHUNK_SIZE; tile_x++)
+    {
+      const auto sprite_id = background_layer_sprite(level, tile_x, tile_y, layer);
+      if (sprite_id == -1)
+      {
+        continue;
+      }
+      if (empty)
+      {
+        empty = false;
+        surface = window_.create_target_surface({TILE_CHUNK_SIZE * SPRITE_W, TILE_CHUNK_SIZE * SPRITE_H});
+        if (!surface)
+        {
+          LOG_ERROR("Could not create background layer %d chunk %d", layer, chunk);
+          return;
+        }
+        window_.set_render_target(surface.get());
+        window_.fill_rect(geometry::Rectangle({0, 0}, surface->size()), {0, 0, 0, 0});
+      }
+      sprite_manager_->render_tile(sprite_id, {tile_x * SPRITE_W, tile_y * SPRITE_H}, chunk_pos);
+    }
+  }
+  window_.set_render_target(game_surface_);
+}
+
 void GameRenderer::render_background() const
 {
-  // TODO: Create a surface of size CAMERA + (background.size() * 16) and render the background
-  //       to it _once_, then just keep render that surface (with game_camera offset) until the
-  //       level changes.
+  update_background_layers();
 
-  for (int tile_y = 0; tile_y < game_->get_level().height; tile_y++)
+  // Blit the visible chunks of each layer, drawing them first if needed
+  const auto& level = snapshot_->level;
+  const geometry::Rectangle level_rect{0, 0, level.width * SPRITE_W, level.height * SPRITE_H};
+  const geometry::Size chunk_size{TILE_CHUNK_SIZE * SPRITE_W, TILE_CHUNK_SIZE * SPRITE_H};
+  const auto layer_offset = [this](const BackgroundLayer& layer)
+  {
+    return geometry::Position{static_cast<int>(render_camera_.position.x() * layer.parallax.x()),
+                              static_cast<int>(render_camera_.position.y() * layer.parallax.y())};
+  };
+  for (int i = 0; i < static_cast<int>(background_layers_.size()); i++)
   {
-    for (int tile_x = 0; tile_x < game_->get_level().width; tile_x++)
+    auto& layer = background_layers_[i];
+    const auto offset = layer_offset(layer);
+    const auto view = geometry::intersection(geometry::Rectangle(offset, CAMERA_SIZE), level_rect);
+    if (view.size.x() <= 0 || view.size.y() <= 0)
+    {
+      continue;
+    }
+    for (int chunk_y = view.position.y() / chunk_size.y(); chunk_y <= (view.position.y() + view.size.y() - 1) / chunk_size.y(); chunk_y++)
     {
-      const auto sprite_id = game_->get_level().get_bg(tile_x, tile_y);
-      if (sprite_id != -1)
+      for (int chunk_x = view.position.x() / chunk_size.x(); chunk_x <= (view.position.x() + view.size.x() - 1) / chunk_size.x(); chunk_x++)
       {
-        // Stars get parallax effect
-        // In main level, they are infinite distance away, but in space levels they
-        // are drawn with random offsets
-        // Horizon tiles get only a horizontal parallax effect
-        const bool is_star = sprite_id >= static_cast<int>(Sprite::SPRITE_STARS_1) && sprite_id <= static_cast<int>(Sprite::SPRITE_STARS_6);
-        const bool is_horizon =
-          (sprite_id >= static_cast<int>(Sprite::SPRITE_HORIZON_1) && sprite_id <= static_cast<int>(Sprite::SPRITE_HORIZON_4)) ||
-          sprite_id >= static_cast<int>(Sprite::SPRITE_HORIZON_LAMP);
-        geometry::Position camera_pos = game_camera_.position;
-        if (is_star)
+        const int chunk = chunk_y * background_chunks_w_ + chunk_x;
+        if (!layer.built[chunk])
         {
-          const double factor = game_->get_level().is_space() ? (tile_x * 31 ^ tile_y * 7) % 6 * 0.1 : 0;
-          camera_pos *= factor;
+          layer.built[chunk] = true;
+          background_chunks_built_.emplace_back(i, chunk);
+          render_background_chunk(i, chunk);
         }
-        else if (is_horizon)
+        const auto& surface = layer.chunks[chunk];
+        if (!surface)
         {
-          // Render horizon with infinite horizontal parallax in addition
-          sprite_manager_->render_tile(
-            static_cast<int>(Sprite::SPRITE_HORIZON), {tile_x * SPRITE_W, tile_y * SPRITE_H}, geometry::Position(0, camera_pos.y()));
-          camera_pos = geometry::Position(static_cast<int>(camera_pos.x() * 0.25), camera_pos.y());
+          continue;
+        }
+        const geometry::Position chunk_pos{chunk_x * chunk_size.x(), chunk_y * chunk_size.y()};
+        const auto src_rect = geometry::intersection(view, geometry::Rectangle(chunk_pos, surface->size()));
+        if (src_rect.size.x() > 0 && src_rect.size.y() > 0)
+        {
+          surface->blit_surface(src_rect - chunk_pos, src_rect - offset);
         }
-        sprite_manager_->render_tile(sprite_id, {tile_x * SPRITE_W, tile_y * SPRITE_H}, camera_pos);
       }
     }
   }
 
+  // Free the chunks that have gone out of view
+  std::erase_if(background_chunks_built_,
+                [&](const std::pair<int, int>& built)
+                {
+                  auto& layer = background_layers_[built.first];
+                  const geometry::Position chunk_pos{(built.second % background_chunks_w_) * chunk_size.x(),
+                                                     (built.second / background_chunks_w_) * chunk_size.y()};
+                  if (is_near_view({chunk_pos, chunk_size}, {layer_offset(layer), CAMERA_SIZE}))
+                  {
+                    return false;
+                  }
+                  layer.chunks[built.second].reset();
+                  layer.built[built.second] = false;
+                  return true;
+                });
+
   // MAIN_LEVEL has some special things that needs to be rendered
-  if (game_->get_level().level_id == LevelId::MAIN_LEVEL)
+  if (snapshot_->level.level_id == LevelId::MAIN_LEVEL)
   {
     // Might be cleaner to have this in a dedicated struct for MainLevel stuff
 
@@ -148,38 +394,38 @@ void GameRenderer::render_background() const
     static unsigned volcano_tick_start = 0u;
 
     // Update volcano
-    if (volcano_active && game_tick_ - volcano_tick_start >= 81u)
+    if (volcano_active && snapshot_->game_tick - volcano_tick_start >= 81u)
     {
       volcano_active = false;
-      volcano_tick_start = game_tick_;
+      volcano_tick_start = snapshot_->game_tick;
     }
-    else if (!volcano_active && game_tick_ - volcano_tick_start >= 220u)
+    else if (!volcano_active && snapshot_->game_tick - volcano_tick_start >= 220u)
     {
       volcano_active = true;
-      volcano_tick_start = game_tick_;
+      volcano_tick_start = snapshot_->game_tick;
     }
 
     // Render volcano fire if active
     if (volcano_active)
     {
-      const auto sprite_id_1 = 752 + ((game_tick_ - volcano_tick_start) / 3) % 4;
+      const auto sprite_id_1 = 752 + ((snapshot_->game_tick - volcano_tick_start) / 3) % 4;
       render_tile(sprite_id_1, {29 * SPRITE_W, 2 * SPRITE_H});
-      const auto sprite_id_2 = 748 + ((game_tick_ - volcano_tick_start) / 3) % 4;
+      const auto sprite_id_2 = 748 + ((snapshot_->game_tick - volcano_tick_start) / 3) % 4;
       render_tile(sprite_id_2, {30 * SPRITE_W, 2 * SPRITE_H});
     }
 
-    if (game_->get_level().show_player_controls)
+    if (snapshot_->level.show_player_controls)
     {
       // Movement
-      sprite_manager_->render_other("icon_walk", {46, 16}, game_camera_.position);
-      sprite_manager_->render_other("key_left", {38, 32}, game_camera_.position);
-      sprite_manager_->render_other("key_right", {52, 32}, game_camera_.position);
+      sprite_manager_->render_other("icon_walk", {46, 16}, render_camera_.position);
+      sprite_manager_->render_other("key_left", {38, 32}, render_camera_.position);
+      sprite_manager_->render_other("key_right", {52, 32}, render_camera_.position);
       // Jump
-      sprite_manager_->render_other("icon_jump", {72, 16}, game_camera_.position);
-      sprite_manager_->render_other("key_z", {72, 32}, game_camera_.position);
+      sprite_manager_->render_other("icon_jump", {72, 16}, render_camera_.position);
+      sprite_manager_->render_other("key_z", {72, 32}, render_camera_.position);
       // Shoot
-      sprite_manager_->render_other("icon_fire", {92, 16}, game_camera_.position);
-      sprite_manager_->render_other("key_x", {92, 32}, game_camera_.position);
+      sprite_manager_->render_other("icon_fire", {92, 16}, render_camera_.position);
+      sprite_manager_->render_other("key_x", {92, 32}, render_camera_.position);
     }
   }
 }
@@ -208,8 +454,8 @@ void GameRenderer::render_player() const
 
   const int sprite = [this]()
   {
-    const auto& player = game_->get_player();
-    if (game_->get_level().is_space())
+    const auto& player = snapshot_->player;
+    if (snapshot_->level.is_space())
     {
       // Render spaceship instead
       return static_cast<int>(player.get_spaceship_sprite());
@@ -293,7 +539,7 @@ void GameRenderer::render_player() const
         }
       }
     }
-    if (player.is_reverse_gravity() ^ (game_->get_level().gravity < 0))
+    if (player.is_reverse_gravity() ^ (snapshot_->gravity < 0))
     {
       sprite += 104;
     }
@@ -301,13 +547,14 @@ void GameRenderer::render_player() const
   }();
   // Note: player size is 12x16 but the sprite is 16x16 so we need to adjust where
   // the player is rendered
-  const auto player_render_pos = game_->get_player().position - geometry::Position{2, 0};
+  const auto& player = snapshot_->player;
+  const auto player_render_pos = player.position + interpolation_offset(player.position - player.prev_position) - geometry::Position{2, 0};
 
-  const geometry::Rectangle dest_rect{player_render_pos - game_camera_.position, 16, 16};
+  const geometry::Rectangle dest_rect{player_render_pos - render_camera_.position, 16, 16};
 
   if (sprite > 0)
   {
-    if (game_->get_player().crushed)
+    if (player.crushed)
     {
       // only render the hat and the feet
       constexpr int feet_h = 2;
@@ -315,14 +562,14 @@ void GameRenderer::render_player() const
       const auto src_rect = sprite_manager_->get_rect_for_tile(sprite);
       const geometry::Rectangle feet_src_rect{src_rect.position.x(), src_rect.position.y() + 16 - feet_h, src_rect.size.x(), feet_h};
       const geometry::Rectangle feet_dest_rect{dest_rect.position.x(), dest_rect.position.y() + 16 - feet_h, dest_rect.size.x(), feet_h};
-      sprite_manager_->get_surface()->blit_surface(feet_src_rect, feet_dest_rect);
-      const int hat_dy = sprite_walking_dy[game_->get_player().walk_tick % sprite_walking_dy.size()];
+      draw_list_.add_surface(layer_, DrawList::TEXTURE_SPRITES, *sprite_manager_->get_surface(), feet_src_rect, feet_dest_rect);
+      const int hat_dy = sprite_walking_dy[player.walk_tick % sprite_walking_dy.size()];
       const geometry::Rectangle hat_src_rect{src_rect.position, src_rect.size.x(), hat_h};
       const geometry::Rectangle hat_dest_rect{
         dest_rect.position.x(), dest_rect.position.y() + 16 - hat_h - feet_h, dest_rect.size.x(), hat_h + hat_dy};
-      sprite_manager_->get_surface()->blit_surface(hat_src_rect, hat_dest_rect);
+      draw_list_.add_surface(layer_, DrawList::TEXTURE_SPRITES, *sprite_manager_->get_surface(), hat_src_rect, hat_dest_rect);
     }
-    else if (game_->get_player().is_flashing())
+    else if (player.is_flashing())
     {
       render_tile(sprite, player_render_pos, {0xff, 0xff, 0xff}, static_cast<int>(ObjectFlags::BRIGHT));
     }
@@ -330,7 +577,7 @@ void GameRenderer::render_player() const
     {
       // Render tough player as red tinted
       const int period = FPS / 8;
-      float d = sprite_manager_->remaster ? (float)(game_->get_player().tough_tick % period) / period : 0;
+      float d = sprite_manager_->remaster ? (float)(player.tough_tick % period) / period : 0;
       if (d > 0.5f)
       {
         d = 1 - d;
@@ -342,141 +589,300 @@ void GameRenderer::render_player() const
 
   if (debug_)
   {
-    window_.render_rectangle(dest_rect, {255, 0, 0});
+    render_debug_rectangle(dest_rect, {255, 0, 0});
   }
 }
 
-void GameRenderer::render_tiles(bool in_front) const
+namespace
+{
+// Tiles that animate or are drawn differently from frame to frame, or that draw outside of their own tile
+bool is_overlay_tile(const Tile& tile)
 {
-  const auto start_tile_x = game_camera_.position.x() > 0 ? game_camera_.position.x() / 16 : 0;
-  const auto start_tile_y = game_camera_.position.y() > 0 ? game_camera_.position.y() / 16 : 0;
-  const auto end_tile_x = (game_camera_.position.x() + game_camera_.size.x()) / 16;
-  const auto end_tile_y = (game_camera_.position.y() + game_camera_.size.y()) / 16;
+  if (tile.is_animated())
+  {
+    return true;
+  }
+  switch (tile.get_sprite())
+  {
+    case static_cast<int>(Sprite::SPRITE_LOW_GRAVITY_2):
+    case static_cast<int>(Sprite::SPRITE_LASER_BEAM_1):
+    case static_cast<int>(Sprite::SPRITE_LASER_BEAM_2):
+    case static_cast<int>(Sprite::SPRITE_CONES):
+    case static_cast<int>(Sprite::SPRITE_KILROY_1):
+    case static_cast<int>(Sprite::SPRITE_WINNERS_1):
+      return true;
+    default:
+      return false;
+  }
+}
+}  // namespace
 
-  for (int tile_y = start_tile_y; tile_y <= end_tile_y; tile_y++)
+void GameRenderer::update_tile_chunks() const
+{
+  const auto& level = snapshot_->level;
+  const bool lights = snapshot_->switch_flags & SWITCH_FLAG_LIGHTS;
+  const int chunks_w = (level.width + TILE_CHUNK_SIZE - 1) / TILE_CHUNK_SIZE;
+  const int chunks_h = (level.height + TILE_CHUNK_SIZE - 1) / TILE_CHUNK_SIZE;
+  if (tile_chunks_tiles_ != level.tiles || tile_chunks_level_id_ != level.level_id)
+  {
+    // New level: start over
+    tile_chunks_tiles_ = level.tiles;
+    tile_chunks_level_id_ = level.level_id;
+    tile_chunks_w_ = chunks_w;
+    tile_chunks_.clear();
+    tile_chunks_.resize(chunks_w * chunks_h);
+    tile_chunks_scanned_.clear();
+  }
+  else if (lights != tile_chunks_lights_ || sprite_manager_->remaster != tile_chunks_remaster_)
   {
-    for (int tile_x = start_tile_x; tile_x <= end_tile_x; tile_x++)
+    // Palette changed: every chunk needs to be redrawn
+    for (const int chunk : tile_chunks_scanned_)
     {
-      const auto& tile = game_->get_level().get_tile(tile_x, tile_y);
-
-      if (debug_ && !tile.is_solid() && tile.is_solid_for_slime())
-      {
-        const geometry::Rectangle dest_rect{geometry::Position(tile_x * SPRITE_W, tile_y * SPRITE_H) - game_camera_.position,
-                                            geometry::Size(SPRITE_W, SPRITE_H)};
-        window_.render_rectangle(dest_rect, {0, 128, 0});
-      }
+      tile_chunks_[chunk].dirty = {true, true};
+    }
+  }
+  tile_chunks_lights_ = lights;
+  tile_chunks_remaster_ = sprite_manager_->remaster;
+}
 
-      if (!tile.valid())
+void GameRenderer::scan_tile_chunk(int chunk) const
+{
+  const auto& level = snapshot_->level;
+  const geometry::Position chunk_tile{(chunk % tile_chunks_w_) * TILE_CHUNK_SIZE, (chunk / tile_chunks_w_) * TILE_CHUNK_SIZE};
+  auto& tile_chunk = tile_chunks_[chunk];
+  tile_chunk.scanned = true;
+  tile_chunks_scanned_.push_back(chunk);
+  for (int tile_y = chunk_tile.y(); tile_y < chunk_tile.y() + TILE_CHUNK_SIZE; tile_y++)
+  {
+    for (int tile_x = chunk_tile.x(); tile_x < chunk_tile.x() + TILE_CHUNK_SIZE; tile_x++)
+    {
+      const auto& tile = level.get_tile(tile_x, tile_y);
+      if (tile.valid() && is_overlay_tile(tile))
       {
-        continue;
+        tile_chunk.overlay_tiles[tile.is_render_in_front() ? 1 : 0].emplace_back(tile_x, tile_y);
       }
+    }
+  }
+}
 
-      if ((in_front && !tile.is_render_in_front()) || (!in_front && tile.is_render_in_front()))
+void GameRenderer::render_tile_chunk(int layer, int chunk) const
+{
+  const auto& level = snapshot_->level;
+  const geometry::Position chunk_tile{(chunk % tile_chunks_w_) * TILE_CHUNK_SIZE, (chunk / tile_chunks_w_) * TILE_CHUNK_SIZE};
+  const geometry::Position chunk_pos{chunk_tile.x() * SPRITE_W, chunk_tile.y() * SPRITE_H};
+  const int palette = (snapshot_->switch_flags & SWITCH_FLAG_LIGHTS) ? PALETTE_NORMAL : PALETTE_EGA_DARK;
+  auto& surface = tile_chunks_[chunk].surfaces[layer];
+  bool empty = true;
+  for (int tile_y = chunk_tile.y(); tile_y < chunk_tile.y() + TILE_CHUNK_SIZE; tile_y++)
+  {
+    for (int tile_x = chunk_tile.x(); tile_x < chunk_tile.x() + TILE_CHUNK_SIZE; tile_x++)
+    {
+      const auto& tile = level.get_tile(tile_x, tile_y);
+      if (!tile.valid() || tile.is_render_in_front() != (layer == 1) || is_overlay_tile(tile))
       {
         continue;
       }
-
-      const auto sprite_id = [&tile](unsigned game_tick)
+      if (empty)
       {
-        if (tile.is_animated())
+        empty = false;
+        if (!surface)
         {
-          return tile.get_sprite() + static_cast<int>((game_tick / 2) % tile.get_sprite_count());
+          surface = window_.create_target_surface({TILE_CHUNK_SIZE * SPRITE_W, TILE_CHUNK_SIZE * SPRITE_H});
+          if (!surface)
+          {
+            LOG_ERROR("Could not create tile chunk %d", chunk);
+            return;
+          }
         }
-        else
-        {
-          return tile.get_sprite();
-        }
-      }(game_tick_);
-      render_tile(sprite_id, {tile_x * SPRITE_W, tile_y * SPRITE_H});
+        window_.set_render_target(surface.get());
+        window_.fill_rect(geometry::Rectangle({0, 0}, surface->size()), {0, 0, 0, 0});
+      }
+      sprite_manager_->render_tile(tile.get_sprite(), {tile_x * SPRITE_W, tile_y * SPRITE_H}, chunk_pos, {0xff, 0xff, 0xff}, palette);
     }
   }
+  if (empty)
+  {
+    surface.reset();
+  }
+  window_.set_render_target(game_surface_);
 }
 
-void GameRenderer::render_objects(const bool in_front) const
+void GameRenderer::render_tiles(bool in_front) const
 {
-  for (const auto& object : game_->get_objects())
+  const auto start_tile_x = render_camera_.position.x() > 0 ? render_camera_.position.x() / 16 : 0;
+  const auto start_tile_y = render_camera_.position.y() > 0 ? render_camera_.position.y() / 16 : 0;
+  const auto end_tile_x = (render_camera_.position.x() + render_camera_.size.x()) / 16;
+  const auto end_tile_y = (render_camera_.position.y() + render_camera_.size.y()) / 16;
+
+  update_tile_chunks();
+  const int layer = in_front ? 1 : 0;
+  const geometry::Size chunk_size{TILE_CHUNK_SIZE * SPRITE_W, TILE_CHUNK_SIZE * SPRITE_H};
+  if (!in_front)
   {
-    if ((object.flags & static_cast<int>(ObjectFlags::RENDER_IN_FRONT)) != in_front)
-    {
-      continue;
-    }
-    static constexpr geometry::Size object_size = geometry::Size(16, 16);
-    const auto sprite_id = object.get_sprite(game_tick_);
-    render_tile(sprite_id, object.position, {0xff, 0xff, 0xff}, object.flags, object.parallax);
-
-    if (debug_)
-    {
-      const geometry::Rectangle dest_rect{object.position - game_camera_.position, object_size};
-      window_.render_rectangle(dest_rect, {255, 0, 0});
-    }
+    // Free the chunks that have gone out of view, none of them are in the draw list
+    std::erase_if(tile_chunks_scanned_,
+                  [&](const int chunk)
+                  {
+                    const geometry::Position chunk_pos{(chunk % tile_chunks_w_) * chunk_size.x(), (chunk / tile_chunks_w_) * chunk_size.y()};
+                    if (is_near_view({chunk_pos, chunk_size}, render_camera_))
+                    {
+                      return false;
+                    }
+                    tile_chunks_[chunk] = TileChunk();
+                    return true;
+                  });
   }
-  if (debug_)
+
+  // Blit the visible static chunks, then draw their animated and special tiles
+  // All chunks are added first so that the overlay tiles, which may reach into a neighbouring chunk, end up on top
+  const int chunks_h = static_cast<int>(tile_chunks_.size()) / std::max(tile_chunks_w_, 1);
+  const int end_chunk_x = std::min(end_tile_x / TILE_CHUNK_SIZE, tile_chunks_w_ - 1);
+  const int end_chunk_y = std::min(end_tile_y / TILE_CHUNK_SIZE, chunks_h - 1);
+  for (int chunk_y = start_tile_y / TILE_CHUNK_SIZE; chunk_y <= end_chunk_y; chunk_y++)
   {
-    for (const auto& hazard : game_->get_level().hazards)
+    for (int chunk_x = start_tile_x / TILE_CHUNK_SIZE; chunk_x <= end_chunk_x; chunk_x++)
     {
-      if (hazard->is_render_in_front() != in_front)
+      const int chunk = chunk_y * tile_chunks_w_ + chunk_x;
+      auto& tile_chunk = tile_chunks_[chunk];
+      if (!tile_chunk.scanned)
       {
-        continue;
+        scan_tile_chunk(chunk);
+      }
+      if (tile_chunk.dirty[layer])
+      {
+        tile_chunk.dirty[layer] = false;
+        render_tile_chunk(layer, chunk);
       }
-      window_.render_rectangle({hazard->position - game_camera_.position, hazard->size}, {255, 128, 0});
-      for (const auto r : hazard->get_detection_rects(game_->get_level()))
+      const auto& surface = tile_chunk.surfaces[layer];
+      if (surface)
       {
-        const geometry::Rectangle dest_rect{r.position - game_camera_.position, r.size};
-        window_.render_rectangle(dest_rect, {255, 255, 0});
+        const geometry::Position chunk_pos{chunk_x * chunk_size.x(), chunk_y * chunk_size.y()};
+        const auto visible = geometry::intersection(render_camera_, geometry::Rectangle(chunk_pos, surface->size()));
+        if (visible.size.x() > 0 && visible.size.y() > 0)
+        {
+          draw_list_.add_surface(layer_, DrawList::TEXTURE_SURFACE + chunk, *surface, visible - chunk_pos, visible - render_camera_.position);
+        }
       }
     }
   }
-}
-
-void GameRenderer::render_enemies(unsigned game_tick) const
-{
-  for (const auto& enemy : game_->get_level().enemies)
+  for (int chunk_y = start_tile_y / TILE_CHUNK_SIZE; chunk_y <= end_chunk_y; chunk_y++)
   {
-    if (geometry::isColliding(enemy->rect(), game_camera_))
+    for (int chunk_x = start_tile_x / TILE_CHUNK_SIZE; chunk_x <= end_chunk_x; chunk_x++)
     {
-      for (const auto& sprite_pos : enemy->get_sprites(game_->get_level()))
+      for (const auto& pos : tile_chunks_[chunk_y * tile_chunks_w_ + chunk_x].overlay_tiles[layer])
       {
-        // Blink if time is stopped
-        // Blink faster when the effect is about to wear off
-        if (game_->get_player().stop_tick == 0 ||
-            (game_->get_player().stop_tick < 2 * FPS / FRAMES_PER_TICK ? (game_tick % 4) < 3 : (game_tick % 10) < 7))
+        if (pos.x() < start_tile_x || pos.x() > end_tile_x || pos.y() < start_tile_y || pos.y() > end_tile_y)
         {
-          render_tile(sprite_pos.sprite_id, sprite_pos.position, {255, 255, 255}, sprite_pos.bright);
+          continue;
         }
+        const auto& tile = snapshot_->level.get_tile(pos.x(), pos.y());
+        const auto sprite_id =
+          tile.is_animated() ? tile.get_sprite() + static_cast<int>((snapshot_->game_tick / 2) % tile.get_sprite_count()) : tile.get_sprite();
+        render_tile(sprite_id, {pos.x() * SPRITE_W, pos.y() * SPRITE_H});
+      }
+    }
+  }
 
-        if (debug_)
+  // After the chunks so that they are drawn on top of them
+  if (debug_ && !in_front)
+  {
+    for (int tile_y = start_tile_y; tile_y <= end_tile_y; tile_y++)
+    {
+      for (int tile_x = start_tile_x; tile_x <= end_tile_x; tile_x++)
+      {
+        const auto& tile = snapshot_->level.get_tile(tile_x, tile_y);
+        if (!tile.is_solid() && tile.is_solid_for_slime())
         {
-          const geometry::Rectangle dest_rect{enemy->position - game_camera_.position, enemy->size};
-          window_.render_rectangle(dest_rect, {255, 0, 0});
+          const geometry::Rectangle dest_rect{geometry::Position(tile_x * SPRITE_W, tile_y * SPRITE_H) - render_camera_.position,
+                                              geometry::Size(SPRITE_W, SPRITE_H)};
+          render_debug_rectangle(dest_rect, {0, 128, 0});
         }
       }
     }
+  }
+}
+
+void GameRenderer::update_visible_objects() const
+{
+  for (auto& objects : visible_objects_)
+  {
+    objects.clear();
+  }
+
+  // Objects are culled in screen space since they may have parallax
+  // The margin covers sprites that are drawn outside of their position, e.g. the low gravity sign
+  const geometry::Rectangle screen_rect{-SPRITE_W, -SPRITE_H, render_camera_.size.x() + 2 * SPRITE_W, render_camera_.size.y() + 2 * SPRITE_H};
+  for (const auto& object : snapshot_->objects)
+  {
+    const geometry::Position camera_pos{static_cast<int>(render_camera_.position.x() * object.parallax.x()),
+                                        static_cast<int>(render_camera_.position.y() * object.parallax.y())};
+    if (geometry::isColliding({object.position - camera_pos, geometry::Size(SPRITE_W, SPRITE_H)}, screen_rect))
+    {
+      visible_objects_[(object.flags & static_cast<int>(ObjectFlags::RENDER_IN_FRONT)) ? 1 : 0].push_back(&object);
+    }
+  }
+}
+
+void GameRenderer::render_objects(const bool in_front) const
+{
+  for (const auto* object : visible_objects_[in_front ? 1 : 0])
+  {
+    static constexpr geometry::Size object_size = geometry::Size(16, 16);
+    const auto sprite_id = object->get_sprite(snapshot_->game_tick);
+    render_tile(sprite_id, object->position + interpolation_offset(object->motion), {0xff, 0xff, 0xff}, object->flags, object->parallax);
+
     if (debug_)
     {
-      for (const auto r : enemy->get_detection_rects(game_->get_level()))
-      {
-        const geometry::Rectangle dest_rect{r.position - game_camera_.position, r.size};
-        window_.render_rectangle(dest_rect, {255, 255, 0});
-      }
+      const geometry::Rectangle dest_rect{object->position - render_camera_.position, object_size};
+      render_debug_rectangle(dest_rect, {255, 0, 0});
+    }
+  }
+}
+
+void GameRenderer::render_enemies() const
+{
+  const auto& player = snapshot_->player;
+  const auto game_tick = snapshot_->game_tick;
+  // Blink if time is stopped
+  // Blink faster when the effect is about to wear off
+  if (player.stop_tick == 0 || (player.stop_tick < 2 * FPS / FRAMES_PER_TICK ? (game_tick % 4) < 3 : (game_tick % 10) < 7))
+  {
+    for (const auto& sprite : snapshot_->enemy_sprites)
+    {
+      render_tile(sprite.sprite_id, sprite.position + interpolation_offset(sprite.motion), {255, 255, 255}, sprite.bright);
     }
   }
 
-  // Falling rocks detection rects
+  // Enemy, hazard and detection rects
   if (debug_)
   {
-    for (const auto& r : game_->get_level().falling_rocks_areas)
+    for (const auto& [rect, color] : snapshot_->debug_rectangles)
     {
-      const geometry::Rectangle dest_rect{r.position - game_camera_.position, r.size};
-      window_.render_rectangle(dest_rect, {255, 0, 255});
+      if (geometry::isColliding(rect, render_camera_))
+      {
+        render_debug_rectangle({rect.position - render_camera_.position, rect.size}, color);
+      }
     }
   }
 }
 
+geometry::Position GameRenderer::interpolation_offset(const geometry::Position& motion) const
+{
+  // Larger jumps are teleports, level changes etc. that shouldn't be animated
+  static constexpr int MAX_MOTION = 2 * SPRITE_W;
+  if (std::abs(motion.x()) > MAX_MOTION || std::abs(motion.y()) > MAX_MOTION)
+  {
+    return {};
+  }
+  // Draw at prev + motion * alpha, i.e. up to one tick behind the simulation
+  return {-static_cast<int>(std::lround(motion.x() * (1.0f - alpha_))), -static_cast<int>(std::lround(motion.y() * (1.0f - alpha_)))};
+}
+
 void GameRenderer::render_complete_border() const
 {
-  if ((game_complete_ticks_ % 8) < 4)
+  if ((snapshot_->game_complete_ticks % 8) < 4)
   {
-    const auto statusbar_rect = geometry::Rectangle(0, 0, game_camera_.size.x() - 1, game_camera_.size.y() - 1);
+    const auto statusbar_rect = geometry::Rectangle(0, 0, render_camera_.size.x() - 1, render_camera_.size.y() - 1);
     window_.render_rectangle(statusbar_rect, {0u, 255u, 0u});
   }
 }
@@ -484,7 +890,7 @@ void GameRenderer::render_complete_border() const
 void GameRenderer::render_statusbar() const
 {
   constexpr auto statusbar_height = CHAR_H;
-  const auto statusbar_rect = geometry::Rectangle(0, game_camera_.size.y() - CHAR_H, game_camera_.size.x(), statusbar_height);
+  const auto statusbar_rect = geometry::Rectangle(0, render_camera_.size.y() - CHAR_H, render_camera_.size.x(), statusbar_height);
 
   window_.fill_rect(statusbar_rect, {0u, 0u, 0u});
 
@@ -492,48 +898,48 @@ void GameRenderer::render_statusbar() const
   // $
   sprite_manager_->render_text(L"$", statusbar_rect.position + geometry::Position(0, dy));
   // score
-  sprite_manager_->render_number(game_->get_score(), statusbar_rect.position + geometry::Position(8 * CHAR_W, dy));
+  sprite_manager_->render_number(snapshot_->score, statusbar_rect.position + geometry::Position(8 * CHAR_W, dy));
   // Gun
   sprite_manager_->render_icon(Icon::ICON_GUN, statusbar_rect.position + geometry::Position(11 * CHAR_W, dy));
   // ammo
-  sprite_manager_->render_number(game_->get_num_ammo(), statusbar_rect.position + geometry::Position(15 * CHAR_W, dy));
+  sprite_manager_->render_number(snapshot_->num_ammo, statusbar_rect.position + geometry::Position(15 * CHAR_W, dy));
   // Hearts
-  for (unsigned i = 0; i < game_->get_player().health_; i++)
+  for (unsigned i = 0; i < snapshot_->player.health_; i++)
   {
     sprite_manager_->render_icon(Icon::ICON_HEART, statusbar_rect.position + geometry::Position((i + 19) * CHAR_W, dy));
   }
   // Key
-  if (game_->get_level().has_key)
+  if (snapshot_->has_key)
   {
     sprite_manager_->render_icon(Icon::ICON_KEY, statusbar_rect.position + geometry::Position(23 * CHAR_W, dy));
   }
   // Timers
   // TODO: how to handle/allow multiple timed powerups
-  if (game_->get_player().power_tick > 0)
+  if (snapshot_->player.power_tick > 0)
   {
     sprite_manager_->render_text(L"*", statusbar_rect.position + geometry::Position(27 * CHAR_W, dy));
-    sprite_manager_->render_number(game_->get_player().power_tick * FRAMES_PER_TICK / FPS,
+    sprite_manager_->render_number(snapshot_->player.power_tick * FRAMES_PER_TICK / FPS,
                                    statusbar_rect.position + geometry::Position(30 * CHAR_W, dy));
     sprite_manager_->render_text(L"*", statusbar_rect.position + geometry::Position(30 * CHAR_W, dy));
   }
-  else if (game_->get_player().gravity_tick > 0)
+  else if (snapshot_->player.gravity_tick > 0)
   {
     sprite_manager_->render_text(L"*", statusbar_rect.position + geometry::Position(27 * CHAR_W, dy));
-    sprite_manager_->render_number(game_->get_player().gravity_tick * FRAMES_PER_TICK / FPS,
+    sprite_manager_->render_number(snapshot_->player.gravity_tick * FRAMES_PER_TICK / FPS,
                                    statusbar_rect.position + geometry::Position(30 * CHAR_W, dy));
     sprite_manager_->render_text(L"*", statusbar_rect.position + geometry::Position(30 * CHAR_W, dy));
   }
-  else if (game_->get_player().stop_tick > 0)
+  else if (snapshot_->player.stop_tick > 0)
   {
     sprite_manager_->render_text(L"*", statusbar_rect.position + geometry::Position(27 * CHAR_W, dy));
-    sprite_manager_->render_number(game_->get_player().stop_tick * FRAMES_PER_TICK / FPS,
+    sprite_manager_->render_number(snapshot_->player.stop_tick * FRAMES_PER_TICK / FPS,
                                    statusbar_rect.position + geometry::Position(30 * CHAR_W, dy));
     sprite_manager_->render_text(L"*", statusbar_rect.position + geometry::Position(30 * CHAR_W, dy));
   }
-  else if (game_->get_player().tough_tick > 0)
+  else if (snapshot_->player.tough_tick > 0)
   {
     sprite_manager_->render_text(L"*", statusbar_rect.position + geometry::Position(27 * CHAR_W, dy));
-    sprite_manager_->render_number(game_->get_player().tough_tick * FRAMES_PER_TICK / FPS,
+    sprite_manager_->render_number(snapshot_->player.tough_tick * FRAMES_PER_TICK / FPS,
                                    statusbar_rect.position + geometry::Position(30 * CHAR_W, dy));
     sprite_manager_->render_text(L"*", statusbar_rect.position + geometry::Position(30 * CHAR_W, dy));
   }
@@ -545,28 +951,53 @@ void GameRenderer::render_tile(const int sprite,
                                int flags,
                                const Vector<double> parallax) const
 {
-  // Show alternate low gravity sign
-  if (sprite == static_cast<int>(Sprite::SPRITE_LOW_GRAVITY_2) && sprite_manager_->remaster)
-  {
-    const char* sign_name = game_->get_level().recoil > 4 ? "heavy_recoil_sign" : "light_recoil_sign";
-    sprite_manager_->render_other(sign_name, pos - geometry::Position(16, 0), game_camera_.position);
-    return;
-  }
-  geometry::Position camera_pos = {static_cast<int>(game_camera_.position.x() * parallax.x()),
-                                   static_cast<int>(game_camera_.position.y() * parallax.y())};
+  geometry::Position camera_pos = {static_cast<int>(render_camera_.position.x() * parallax.x()),
+                                   static_cast<int>(render_camera_.position.y() * parallax.y())};
   // Show projectiles as bright if remaster since they can be hard to see
-  const bool flash_projectile = sprite_manager_->remaster && (game_tick_ & 1) &&
+  const bool flash_projectile = sprite_manager_->remaster && (snapshot_->game_tick & 1) &&
     (sprite == static_cast<int>(Sprite::SPRITE_LASER_BEAM_1) || sprite == static_cast<int>(Sprite::SPRITE_LASER_BEAM_2));
+  int palette = PALETTE_NORMAL;
   if ((flags & static_cast<int>(ObjectFlags::BRIGHT)) || flash_projectile)
   {
-    sprite_manager_->render_tile(sprite + SPRITE_TOTAL * 2, pos, camera_pos, color);
+    palette = PALETTE_EGA_WHITE;
   }
-  else if (!(game_->get_level().switch_flags & SWITCH_FLAG_LIGHTS))
+  else if (!(snapshot_->switch_flags & SWITCH_FLAG_LIGHTS))
   {
-    sprite_manager_->render_tile(sprite + SPRITE_TOTAL, pos, camera_pos, color);
+    palette = PALETTE_EGA_DARK;
   }
-  else
+  geometry::Rectangle dest{pos - camera_pos, SPRITE_W, SPRITE_H};
+  if (sprite == static_cast<int>(Sprite::SPRITE_LOW_GRAVITY_2))
+  {
+    // The remastered sign is two tiles wide and drawn a tile to the left
+    dest = {dest.position - geometry::Position(SPRITE_W, 0), 2 * SPRITE_W, SPRITE_H};
+  }
+  draw_list_.add_sprite(layer_, sprite, pos, camera_pos, dest, color, palette);
+}
+
+void GameRenderer::render_debug_rectangle(const geometry::Rectangle& rect, const Color color) const
+{
+  debug_rectangles_.emplace_back(rect, color);
+}
+
+void GameRenderer::submit_draw_list() const
+{
+  draw_list_.sort();
+  for (size_t i = 0; i < draw_list_.size(); i++)
   {
-    sprite_manager_->render_tile(sprite, pos, camera_pos, color);
+    const auto& command = draw_list_[i];
+    if (command.surface)
+    {
+      window_.blit_batched(*command.surface, command.source, command.dest);
+    }
+    else if (command.sprite == static_cast<int>(Sprite::SPRITE_LOW_GRAVITY_2) && sprite_manager_->remaster)
+    {
+      // Show alternate low gravity sign
+      const char* sign_name = snapshot_->level.recoil > 4 ? "heavy_recoil_sign" : "light_recoil_sign";
+      sprite_manager_->render_other(sign_name, command.position - geometry::Position(16, 0), command.camera_position);
+    }
+    else
+    {
+      sprite_manager_->render_tile(command.sprite, command.position, command.camera_position, command.color, command.palette);
+    }
   }
 }
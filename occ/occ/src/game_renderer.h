@@ -1,7 +1,18 @@
 #pragma once
 
+#include <array>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "chunked_grid.h"
+#include "draw_list.h"
 #include "geometry.h"
 #include "graphics.h"
+#include "level_id.h"
+#include "render_snapshot.h"
+#include "tile.h"
+#include "triple_buffer.h"
 
 class Game;
 class SpriteManager;
@@ -13,8 +24,14 @@ class GameRenderer
  public:
   GameRenderer(Game* game, SpriteManager* sprite_manager, Surface* game_surface, Window& window);
 
+  // Called at the end of each game tick: moves the camera and publishes a snapshot of the game
   void update(unsigned game_tick);
-  void render_game(unsigned game_tick) const;
+  // Publishes a snapshot of the game as it is now, e.g. after a new level has been loaded
+  void publish_snapshot();
+  // Draws the latest published snapshot; the Game itself is not accessed
+  // alpha is how far into the next tick this frame is drawn, in [0, 1]
+  // Moving things are drawn between their previous and current positions so motion is smooth at any frame rate
+  void render_game(const float alpha = 1.0f) const;
 
   const geometry::Rectangle& get_game_camera() const { return game_camera_; }
 
@@ -23,10 +40,16 @@ class GameRenderer
 
  private:
   void render_background() const;
+  void update_background_layers() const;
+  void render_background_chunk(int layer, int chunk) const;
   void render_player() const;
+  void update_tile_chunks() const;
+  void scan_tile_chunk(int chunk) const;
+  void render_tile_chunk(int layer, int chunk) const;
   void render_tiles(bool in_front) const;
+  void update_visible_objects() const;
   void render_objects(const bool in_front) const;
-  void render_enemies(unsigned game_tick) const;
+  void render_enemies() const;
   void render_complete_border() const;
   void render_statusbar() const;
   void render_tile(const int sprite,
@@ -34,17 +57,73 @@ class GameRenderer
                    const Color color = {0xff, 0xff, 0xff},
                    int flags = 0,
                    const Vector<double> parallax = {1.0, 1.0}) const;
+  void render_debug_rectangle(const geometry::Rectangle& rect, const Color color) const;
+  // Offset from the current position to the interpolated one, for something that moved motion during the last tick
+  geometry::Position interpolation_offset(const geometry::Position& motion) const;
+  void submit_draw_list() const;
 
   Game* game_;
   SpriteManager* sprite_manager_;
   Surface* game_surface_;
   Window& window_;
 
+  // Simulation side
   geometry::Rectangle game_camera_;
-
+  geometry::Position prev_camera_position_;
   unsigned game_tick_;
   unsigned game_tick_diff_;
   unsigned game_complete_ticks_ = 20;
 
   bool debug_;
+
+  // Snapshots are handed from the simulation to the renderer without either waiting for the other
+  // Both run on the main thread for now, drawing could move to its own thread without changing this
+  mutable TripleBuffer<RenderSnapshot> snapshots_;
+
+  // Render side: the snapshot being drawn and the camera interpolated between ticks, used for everything drawn this frame
+  mutable const RenderSnapshot* snapshot_ = nullptr;
+  mutable geometry::Rectangle render_camera_;
+  mutable float alpha_ = 1.0f;
+
+  // Background tiles pre-rendered per parallax factor, rebuilt when the level or remaster mode changes
+  // Layers are split into chunks that are drawn when they come into view and freed when far from it
+  struct BackgroundLayer
+  {
+    Vector<double> parallax;
+    std::vector<std::unique_ptr<Surface>> chunks;
+    std::vector<bool> built;
+  };
+  mutable std::vector<BackgroundLayer> background_layers_;
+  // (layer, chunk) of each built background chunk
+  mutable std::vector<std::pair<int, int>> background_chunks_built_;
+  mutable int background_chunks_w_ = 0;
+  mutable bool background_valid_ = false;
+  mutable LevelId background_level_id_ = LevelId::INTRO;
+  mutable bool background_remaster_ = false;
+
+  // Static tiles pre-rendered into chunks per layer (back, front); animated and special tiles are drawn each frame
+  // Chunks are scanned when they come into view and freed when far from it, so the cost follows the view, not the level
+  static constexpr int TILE_CHUNK_SIZE = 16;
+  struct TileChunk
+  {
+    std::array<std::unique_ptr<Surface>, 2> surfaces;
+    std::array<bool, 2> dirty = {true, true};
+    std::array<std::vector<geometry::Position>, 2> overlay_tiles;
+    bool scanned = false;
+  };
+  mutable std::vector<TileChunk> tile_chunks_;
+  mutable std::vector<int> tile_chunks_scanned_;
+  mutable int tile_chunks_w_ = 0;
+  mutable std::shared_ptr<const ChunkedGrid<Tile>> tile_chunks_tiles_;
+  mutable LevelId tile_chunks_level_id_ = LevelId::INTRO;
+  mutable bool tile_chunks_lights_ = true;
+  mutable bool tile_chunks_remaster_ = false;
+
+  // Objects on screen this frame, per layer (back, front)
+  mutable std::array<std::vector<const Object*>, 2> visible_objects_;
+
+  // Sprites are collected per frame and drawn sorted by layer and texture, debug rectangles are drawn on top
+  mutable DrawList draw_list_;
+  mutable DrawList::Layer layer_ = DrawList::Layer::BACKGROUND;
+  mutable std::vector<std::pair<geometry::Rectangle, Color>> debug_rectangles_;
 };
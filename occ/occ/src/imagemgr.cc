@@ -8,6 +8,7 @@
 
 #include "logger.h"
 #include "path.h"
+#include "thread_pool.h"
 
 static std::string image_extensions[] = {"APG", "TTL", "CDT", "END"};
 
@@ -23,88 +24,171 @@ std::filesystem::path get_image_path(const int episode, const CCImage image, con
   return get_data_path(filename);
 }
 
-std::unique_ptr<Surface> load_surface(Window& window, const int episode, const CCImage image, const int index)
+std::unique_ptr<Image> load_image(const int episode, const CCImage image, const int index)
 {
   auto path = get_image_path(episode, image, index);
   if (path.empty())
   {
     return nullptr;
   }
-  auto surface = Surface::from_pcx_image(path, window);
-  if (!surface)
+  auto decoded = Image::from_pcx_image(path);
+  if (!decoded)
   {
     LOG_CRITICAL("Could not load '%s'", path.c_str());
     return nullptr;
   }
-  return surface;
+  return decoded;
 }
 
-bool ImageManager::load_images(Window& window)
+ImageManager::ImageManager(Window& window, ThreadPool* thread_pool, const size_t budget_bytes)
+  : window_(window),
+    thread_pool_(thread_pool),
+    budget_bytes_(budget_bytes)
 {
-  // Check if images already loaded
-  if (!episode_images_.empty())
+}
+
+ImageManager::~ImageManager()
+{
+  // Prefetch jobs refer to this, so let them finish
+  std::unique_lock<std::mutex> lock(mutex_);
+  decoded_.wait(lock, [this] { return in_flight_ == 0; });
+}
+
+std::vector<std::unique_ptr<Image>> ImageManager::decode_images(const int episode, const CCImage image)
+{
+  std::vector<std::unique_ptr<Image>> images;
+  auto decoded = load_image(episode, image, 0);
+  if (decoded != nullptr)
   {
-    return false;
+    images.emplace_back(std::move(decoded));
+    return images;
   }
+  // Try again but with different image indices
+  for (int index = 1;; index++)
+  {
+    decoded = load_image(episode, image, index);
+    if (decoded == nullptr)
+    {
+      break;
+    }
+    images.emplace_back(std::move(decoded));
+  }
+  return images;
+}
 
-  // Load images
-  bool end = false;
-  for (int episode = 1; !end; episode++)
+const std::vector<Surface*>& ImageManager::get_images(const int episode, const CCImage image)
+{
+  const Key key{episode, image};
+  auto it = entries_.find(key);
+  if (it == entries_.end())
   {
-    std::array<std::vector<std::unique_ptr<Surface>>, 4> episode_surfaces;
-    int loaded = 0;
-    for (int image = IMAGE_APOGEE; image <= IMAGE_END; image++)
+    // Use the prefetched images if there are any, otherwise decode them now
+    std::vector<std::unique_ptr<Image>> decoded;
+    std::unique_lock<std::mutex> lock(mutex_);
+    const auto pending = pending_.find(key);
+    if (pending != pending_.end())
     {
-      std::vector<std::unique_ptr<Surface>> image_surfaces;
-      auto surface = load_surface(window, episode, (CCImage)image, 0);
-      if (surface == nullptr)
-      {
-        // Try again but with different image indices
-        for (int index = 1;; index++)
-        {
-          surface = load_surface(window, episode, (CCImage)image, index);
-          if (surface == nullptr)
-          {
-            break;
-          }
-          loaded++;
-          image_surfaces.emplace_back(std::move(surface));
-        }
-        if (image_surfaces.empty())
-        {
-          if (episode == 1)
-          {
-            LOG_CRITICAL("Could not find game image %d", image);
-            return false;
-          }
-          end = true;
-          continue;
-        }
-      }
-      else
+      const auto prefetched = pending->second;
+      decoded_.wait(lock, [&prefetched] { return prefetched->done; });
+      decoded = std::move(prefetched->images);
+      pending_.erase(key);
+      lock.unlock();
+    }
+    else
+    {
+      lock.unlock();
+      decoded = decode_images(episode, image);
+    }
+
+    Entry entry;
+    for (const auto& decoded_image : decoded)
+    {
+      auto surface = Surface::from_image_data(*decoded_image, window_);
+      if (!surface)
       {
-        loaded++;
-        image_surfaces.emplace_back(std::move(surface));
+        LOG_ERROR("Could not create surface for image %d of episode %d", image, episode);
+        continue;
       }
-      episode_surfaces[image] = std::move(image_surfaces);
+      entry.bytes += static_cast<size_t>(surface->width()) * surface->height() * sizeof(uint32_t);
+      entry.images.push_back(surface.get());
+      entry.surfaces.emplace_back(std::move(surface));
     }
-    if (loaded > 0)
+    if (entry.images.empty())
     {
-      episode_images_.emplace_back(std::move(episode_surfaces));
+      // Cached like any other entry, so this is only logged once
+      LOG_ERROR("No images %d of episode %d, they will not be drawn", image, episode);
     }
+    total_bytes_ += entry.bytes;
+    it = entries_.emplace(key, std::move(entry)).first;
   }
+  it->second.last_used = ++use_counter_;
+  return it->second.images;
+}
 
-  return true;
+void ImageManager::prefetch(const int episode, const CCImage image)
+{
+  const Key key{episode, image};
+  if (!thread_pool_ || entries_.find(key) != entries_.end())
+  {
+    return;
+  }
+  std::shared_ptr<Pending> pending;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (pending_.find(key) != pending_.end())
+    {
+      return;
+    }
+    pending = std::make_shared<Pending>();
+    pending_[key] = pending;
+    in_flight_++;
+  }
+  thread_pool_->post(
+    [this, pending, episode, image]
+    {
+      auto images = decode_images(episode, image);
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending->images = std::move(images);
+        pending->done = true;
+        in_flight_--;
+        // Under the lock: once in_flight_ is 0 the destructor may return and destroy decoded_
+        decoded_.notify_all();
+      }
+    });
+}
+
+void ImageManager::trim()
+{
+  while (total_bytes_ > budget_bytes_ && !entries_.empty())
+  {
+    auto lru = entries_.begin();
+    for (auto it = entries_.begin(); it != entries_.end(); ++it)
+    {
+      if (it->second.last_used < lru->second.last_used)
+      {
+        lru = it;
+      }
+    }
+    LOG_DEBUG("Releasing image %d of episode %d", lru->first.second, lru->first.first);
+    total_bytes_ -= lru->second.bytes;
+    entries_.erase(lru);
+  }
 }
 
-std::vector<Surface*> ImageManager::get_images(size_t episode, CCImage image) const
+size_t ImageManager::number_of_episodes() const
 {
-  std::vector<Surface*> images;
-  const auto& episode_images = episode_images_[episode - 1];
-  const auto& type_images = episode_images[(int)image];
-  for (auto&& surface : type_images)
+  if (number_of_episodes_ == 0)
   {
-    images.push_back(surface.get());
+    // Count the episodes that have a splash image, without loading anything
+    for (int episode = 1;; episode++)
+    {
+      if (get_image_path(episode, IMAGE_APOGEE, 0).empty() && get_image_path(episode, IMAGE_APOGEE, 1).empty())
+      {
+        break;
+      }
+      number_of_episodes_ = episode;
+    }
   }
-  return images;
+  return number_of_episodes_;
 }
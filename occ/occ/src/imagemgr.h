@@ -1,12 +1,19 @@
 #pragma once
 
 #include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <utility>
 #include <vector>
 
 #include "geometry.h"
 #include "graphics.h"
 
+class ThreadPool;
+
 enum CCImage
 {
   IMAGE_APOGEE = 0,   // ext .APG
@@ -15,16 +22,57 @@ enum CCImage
   IMAGE_END = 3,      // ext .END
 };
 
+// Roughly 16 full screen images
+#define IMAGE_BUDGET_BYTES (4 * 1024 * 1024)
+
+/// Loads the episode images on demand, keyed by episode and image type
+/// Images that have not been used recently are released once over budget
 class ImageManager
 {
  public:
-  ImageManager() : episode_images_() {}
+  // Without a thread pool, prefetch does nothing and all images are loaded by get_images
+  explicit ImageManager(Window& window, ThreadPool* thread_pool = nullptr, const size_t budget_bytes = IMAGE_BUDGET_BYTES);
+  ~ImageManager();
 
-  bool load_images(Window& window);
-  size_t number_of_episodes() const { return episode_images_.size(); }
-  std::vector<Surface*> get_images(size_t episode, CCImage image) const;
+  // Loads the images if needed; the surfaces are valid until the next call to trim
+  // Returns an empty vector if there are no such images
+  const std::vector<Surface*>& get_images(const int episode, const CCImage image);
+  // Starts decoding the images in the background, so that they are ready when they are needed
+  void prefetch(const int episode, const CCImage image);
+  // Releases least recently used images until within budget; call when no surfaces are held, e.g. after each frame
+  void trim();
+  size_t number_of_episodes() const;
 
  private:
-  // Episode, image type, images
-  std::vector<std::array<std::vector<std::unique_ptr<Surface>>, 4>> episode_images_;
+  using Key = std::pair<int, CCImage>;
+
+  struct Entry
+  {
+    std::vector<std::unique_ptr<Surface>> surfaces;
+    std::vector<Surface*> images;
+    size_t bytes = 0;
+    uint64_t last_used = 0;
+  };
+
+  struct Pending
+  {
+    bool done = false;
+    std::vector<std::unique_ptr<Image>> images;
+  };
+
+  static std::vector<std::unique_ptr<Image>> decode_images(const int episode, const CCImage image);
+
+  Window& window_;
+  ThreadPool* thread_pool_;
+  size_t budget_bytes_;
+  std::map<Key, Entry> entries_;
+  size_t total_bytes_ = 0;
+  uint64_t use_counter_ = 0;
+  mutable size_t number_of_episodes_ = 0;
+
+  // Shared with the prefetch jobs
+  std::mutex mutex_;
+  std::condition_variable decoded_;
+  std::map<Key, std::shared_ptr<Pending>> pending_;
+  unsigned in_flight_ = 0;
 };
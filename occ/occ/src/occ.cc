@@ -1,12 +1,17 @@
 #include <cassert>
+#include <cmath>
 #include <cstdio>
+#include <algorithm>
 #include <cstdlib>
 
 #include <format>
 #include <memory>
+#include <string_view>
 #include <utility>
 
+#include "asset_loader.h"
 #include "constants.h"
+#include "frame_pacer.h"
 #include "game_renderer.h"
 #include "imagemgr.h"
 #include "player_state.h"
@@ -15,15 +20,65 @@
 #include "utils.h"
 
 // From utils
+#include "frame_capture.h"
 #include "geometry.h"
 #include "logger.h"
 #include "path.h"
+#include "profiler.h"
+#include "thread_pool.h"
 
 #define ICON_FILENAME_FMT "caves{}.ico"
 
 
-int main()
+int main(int argc, char* argv[])
 {
+  // Time the startup phases, see build/startup_benchmark.sh
+  Profiler profiler;
+  bool startup_report = false;
+  bool exit_after_startup = false;
+  bool headless = false;
+  bool vsync = true;
+  std::filesystem::path capture_path;
+  int prefetch_tiles = -1;
+  for (int i = 1; i < argc; i++)
+  {
+    const std::string_view arg = argv[i];
+    if (arg == "--startup-report")
+    {
+      // Print the startup phase timings to stdout
+      startup_report = true;
+    }
+    else if (arg == "--exit-after-startup")
+    {
+      // Quit once all states have been created and a frame presented
+      exit_after_startup = true;
+    }
+    else if (arg == "--headless")
+    {
+      // Render in CPU memory without opening a window
+      headless = true;
+    }
+    else if (arg == "--no-vsync")
+    {
+      // Pace the frames with the game tick instead of the display
+      vsync = false;
+    }
+    else if (arg == "--capture" && i + 1 < argc)
+    {
+      // Record the game to a .y4m file, or to a directory of PNG files
+      capture_path = argv[++i];
+    }
+    else if (arg == "--prefetch-distance" && i + 1 < argc)
+    {
+      // Load the next level in the background when the player is this many tiles from its entrance, 0 to disable
+      prefetch_tiles = std::max(0, std::atoi(argv[++i]));
+    }
+    else
+    {
+      LOG_ERROR("Unknown argument %s", argv[i]);
+    }
+  }
+
   LOG_INFO("Starting!");
 
   srand(static_cast<unsigned int>(time(nullptr)));
@@ -35,12 +90,13 @@ int main()
     LOG_CRITICAL("Could not create SDLWrapper");
     return 1;
   }
-  if (!sdl->init())
+  if (!sdl->init(headless))
   {
     LOG_CRITICAL("Could not initialize SDLWrapper");
     return 1;
   }
   LOG_INFO("SDLWrapper initialized");
+  profiler.lap("sdl_init");
 
   // TODO: select episode
   const int episode = 1;
@@ -52,13 +108,14 @@ int main()
   {
     LOG_ERROR("could not find icon file %s", icon_file.c_str());
   }
-  auto window = Window::create("OpenCrystalCaves", WINDOW_SIZE, icon_path);
+  auto window = headless ? Window::create_software(WINDOW_SIZE) : Window::create("OpenCrystalCaves", WINDOW_SIZE, icon_path);
   if (!window)
   {
     LOG_CRITICAL("Could not create Window");
     return 1;
   }
   LOG_INFO("Window created");
+  profiler.lap("window");
 
   // Create game surface
   auto game_surface = window->create_target_surface(CAMERA_SIZE);
@@ -76,85 +133,155 @@ int main()
     LOG_CRITICAL("Could not create event handler");
     return 1;
   }
+  profiler.lap("game_surface_and_events");
 
-  // Load tileset
+  // Load assets in the background
+  // Decoding happens on worker threads and the surfaces are created here as each asset finishes,
+  // so that the splash screen can be shown as soon as its image (and the sounds) are ready
+  // The pool is declared after everything its jobs write to, and the loaders wait for their jobs when destroyed,
+  // so that returning early never leaves a job running against a destroyed object
   SpriteManager sprite_manager;
-  if (!sprite_manager.load_tilesets(*window, episode))
-  {
-    LOG_CRITICAL("Could not load tilesets");
-    return 1;
-  }
-  LOG_INFO("Tileset loaded");
+  SoundManager sound_manager;
+  std::unique_ptr<ExeData> exe_data;
+  ThreadPool thread_pool;
+  AssetLoader asset_loader(thread_pool);
 
-  // Load image manager
-  ImageManager image_manager;
-  if (!image_manager.load_images(*window))
-  {
-    LOG_CRITICAL("Could not load images");
-    return 1;
-  }
-  LOG_INFO("Images loaded");
+  asset_loader.add("tilesets",
+                   [&sprite_manager, &window, &profiler, episode]() -> AssetLoader::Upload
+                   {
+                     const auto scope = profiler.scope("load_tilesets_decode");
+                     if (!sprite_manager.decode_tilesets(episode))
+                     {
+                       return nullptr;
+                     }
+                     return [&sprite_manager, &window, &profiler]
+                     {
+                       const auto upload_scope = profiler.scope("load_tilesets_upload");
+                       return sprite_manager.upload_tilesets(*window);
+                     };
+                   });
 
-  // Load sound manager
-  SoundManager sound_manager;
-  if (!sound_manager.load_sounds(episode))
-  {
-    LOG_CRITICAL("Could not load sounds");
-    return 1;
-  }
-  LOG_INFO("Sounds loaded");
+  // Images are loaded on demand; start with the splash screen and the title screen that follows it
+  ImageManager image_manager(*window, &thread_pool);
+  image_manager.prefetch(episode, CCImage::IMAGE_APOGEE);
+  image_manager.prefetch(episode, CCImage::IMAGE_TITLE);
+  image_manager.prefetch(episode, CCImage::IMAGE_CREDITS);
 
-  // Load player state from config file
-  PlayerState player_state{episode};
+  asset_loader.add("sounds",
+                   [&sound_manager, &profiler, episode]() -> AssetLoader::Upload
+                   {
+                     const auto scope = profiler.scope("load_sounds");
+                     if (!sound_manager.load_sounds(episode))
+                     {
+                       return nullptr;
+                     }
+                     return [] { return true; };
+                   });
 
-  // Create Game
-  std::unique_ptr<Game> game = Game::create();
-  if (!game)
-  {
-    LOG_CRITICAL("Could not create Game");
-    return 1;
-  }
-  ExeData exe_data{episode};
-  if (!game->init(sound_manager, exe_data, LevelId::INTRO, player_state, LevelId::INTRO))
+  asset_loader.add("exe data",
+                   [&exe_data, &profiler, episode]() -> AssetLoader::Upload
+                   {
+                     const auto scope = profiler.scope("exe_data");
+                     exe_data = std::make_unique<ExeData>(episode);
+                     return [] { return true; };
+                   });
+
+  profiler.lap("start_loading");
+
+  // Create splash state as soon as possible
+  if (image_manager.get_images(episode, CCImage::IMAGE_APOGEE).empty() || !asset_loader.wait("sounds"))
   {
-    LOG_CRITICAL("Could not initialize Game");
+    LOG_CRITICAL("Could not load splash screen");
     return 1;
   }
-  LOG_INFO("Game initialized");
-
-  // Create game states
-  // TODO: more episodes
-  auto splash_images = image_manager.get_images(episode, CCImage::IMAGE_APOGEE);
-  SplashState splash{sound_manager, splash_images, *window};
-  auto title_images = image_manager.get_images(episode, CCImage::IMAGE_TITLE);
-  auto credits_images = image_manager.get_images(episode, CCImage::IMAGE_CREDITS);
-  auto end_images = image_manager.get_images(episode, CCImage::IMAGE_END);
-  title_images.insert(title_images.end(), credits_images.begin(), credits_images.end());
-  TitleState title{episode, sprite_manager, sound_manager, *game_surface, title_images, *window, exe_data, player_state};
-  splash.set_next(title);
-  EndState end_state = EndState(sprite_manager, sound_manager, *game_surface, end_images, *window, exe_data);
-  end_state.set_next(title);
-  GameState game_state(*game, sprite_manager, sound_manager, *game_surface, *window, exe_data, player_state, end_state);
-  title.set_next(game_state);
-  game_state.set_next(title);
+  SplashState splash{episode, sound_manager, image_manager, *window};
   State* state = &splash;
   state->reset();
+  profiler.lap("load_splash");
+
+  // The other game states are created once all assets have been loaded
+  std::unique_ptr<PlayerState> player_state;
+  std::unique_ptr<Game> game;
+  std::unique_ptr<TitleState> title;
+  std::unique_ptr<EndState> end_state;
+  std::unique_ptr<GameState> game_state;
+  std::unique_ptr<FrameCapture> frame_capture;
+  const auto create_states = [&]() -> bool
+  {
+    {
+      const auto scope = profiler.scope("wait_assets");
+      if (!asset_loader.wait_all())
+      {
+        LOG_CRITICAL("Could not load assets");
+        return false;
+      }
+    }
+    LOG_INFO("Assets loaded");
+
+    // Load player state from config file
+    {
+      const auto scope = profiler.scope("player_state");
+      player_state = std::make_unique<PlayerState>(episode);
+    }
+
+    // Create Game
+    {
+      const auto scope = profiler.scope("game_init");
+      game = Game::create();
+      if (!game)
+      {
+        LOG_CRITICAL("Could not create Game");
+        return false;
+      }
+      if (prefetch_tiles >= 0)
+      {
+        game->prefetch_distance = prefetch_tiles * SPRITE_W;
+      }
+      if (!game->init(sound_manager, *exe_data, LevelId::INTRO, *player_state, LevelId::INTRO))
+      {
+        LOG_CRITICAL("Could not initialize Game");
+        return false;
+      }
+    }
+    LOG_INFO("Game initialized");
+
+    // Create game states (this includes decoding the panel texts)
+    // TODO: more episodes
+    const auto scope = profiler.scope("states");
+    title = std::make_unique<TitleState>(episode, sprite_manager, sound_manager, *game_surface, image_manager, *window, *exe_data, *player_state);
+    splash.set_next(*title);
+    end_state = std::make_unique<EndState>(episode, sprite_manager, sound_manager, *game_surface, image_manager, *window, *exe_data);
+    end_state->set_next(*title);
+    game_state =
+      std::make_unique<GameState>(*game, sprite_manager, sound_manager, *game_surface, *window, *exe_data, *player_state, *end_state);
+    title->set_next(*game_state);
+    game_state->set_next(*title);
+    if (!capture_path.empty())
+    {
+      // One frame per game tick
+      frame_capture = FrameCapture::create(capture_path, CAMERA_SIZE, FPS, FRAMES_PER_TICK);
+      if (!frame_capture)
+      {
+        LOG_CRITICAL("Could not start frame capture");
+        return false;
+      }
+      game_state->set_frame_capture(frame_capture.get());
+    }
+    return true;
+  };
+  bool first_frame = true;
+  bool startup_complete = false;
 
   // Game loop
   {
     // Game variables
     Input input;
 
-    // Game loop logic
-    auto sdl_tick = sdl->get_tick();
-    auto tick_last_update = sdl_tick;
-    auto lag = 0u;
-
-    // FPS logic
-    auto fps_num_renders = 0u;
-    auto fps_last_calc = sdl_tick;
-    auto fps_start_time = sdl_tick;
-    auto fps = 0u;
+    // Game loop logic, FPS / FRAMES_PER_TICK ticks per second
+    // With vsync refresh() waits for the display, otherwise a frame is rendered for each tick
+    vsync = vsync && window->set_vsync(true);
+    LOG_INFO("vsync %s", vsync ? "on" : "off");
+    FramePacer frame_pacer(*sdl, FPS, FRAMES_PER_TICK);
 
     while (true)
     {
@@ -163,25 +290,41 @@ int main()
       ///  Logic
       ///
       /////////////////////////////////////////////////////////////////////////
-      while (true)
+      // Sounds are thinned out when running faster than real time so they don't pile up
+      frame_pacer.set_time_scale(state->get_time_scale());
+      sound_manager.set_time_scale(state->get_time_scale());
+      if (vsync && frame_pacer.outpaces_display(window->get_refresh_rate()))
       {
-        sdl_tick = sdl->get_tick();
-        auto elapsed_ticks = sdl_tick - tick_last_update;
-        tick_last_update = sdl_tick;
-        lag += elapsed_ticks;
-        if (lag >= MS_PER_TICK)
-        {
-          break;
-        }
-        sdl->delay(MS_PER_TICK - lag);
+        // Some drivers accept vsync but don't wait for the display, the loop would then spin
+        LOG_INFO("vsync isn't limiting the frame rate (%.0f fps), pacing by ticks instead", frame_pacer.get_fps());
+        vsync = false;
+      }
+      if (!vsync)
+      {
+        frame_pacer.wait_for_tick();
       }
-      while (lag >= MS_PER_TICK)
+      for (auto ticks = frame_pacer.advance(); ticks > 0; ticks--)
       {
         // Read input
         event->poll_event(&input);
 
         // Handle input
         state->update(input);
+
+        // Create the surfaces of decoded assets, and the remaining states once everything is loaded
+        // (waiting for the stragglers if the splash screen has already finished)
+        if (!game_state)
+        {
+          if (!asset_loader.poll())
+          {
+            LOG_CRITICAL("Could not load assets");
+            return 1;
+          }
+          if ((asset_loader.done() || state->has_finished()) && !create_states())
+          {
+            return 1;
+          }
+        }
         auto new_state = state->next_state();
         if (new_state != state)
         {
@@ -192,8 +335,6 @@ int main()
           new_state->reset();
           state = new_state;
         }
-
-        lag -= MS_PER_TICK;
       }
 
       /////////////////////////////////////////////////////////////////////////
@@ -202,27 +343,45 @@ int main()
       ///
       /////////////////////////////////////////////////////////////////////////
 
+      // Drawn on the same thread as input and the ticks, so a slow present or vsync still delays both
+      // The game is only drawn from GameRenderer's snapshots, which a separate render thread could consume instead
+      state->set_tick_alpha(frame_pacer.get_alpha());
       state->draw(*window);
 
-      // Render FPS
-      auto fps_str = L"fps: " + std::to_wstring(fps);
-      sprite_manager.render_text(fps_str, geometry::Position(5, 5));
+      // Render FPS (once the font has loaded)
+      if (sprite_manager.get_char_surface())
+      {
+        auto fps_str = L"fps: " + std::to_wstring(std::lround(frame_pacer.get_fps()));
+        sprite_manager.render_text(fps_str, geometry::Position(5, 5));
+      }
 
       // Update screen
       window->refresh();
 
-      // Calculate FPS each second
-      fps_num_renders++;
-      if (sdl_tick >= (fps_last_calc + 1000))
+      if (first_frame)
       {
-        const auto total_time = sdl_tick - fps_start_time;
-        fps = fps_num_renders / (total_time / 1000);
-        fps_last_calc = sdl_tick;
-
-        // Reset
-        fps_num_renders = 0;
-        fps_start_time = sdl_tick;
+        profiler.mark("first_frame");
+        first_frame = false;
+      }
+      if (!startup_complete && game_state)
+      {
+        profiler.mark("startup_complete");
+        startup_complete = true;
+        if (startup_report)
+        {
+          fputs(profiler.report().c_str(), stdout);
+          fflush(stdout);
+        }
+        if (exit_after_startup)
+        {
+          return 0;
+        }
       }
+
+      // Release images that haven't been used recently
+      image_manager.trim();
+
+      frame_pacer.count_frame();
     }
   }
 
@@ -1,5 +1,6 @@
 #include "panel.h"
 
+#include <algorithm>
 #include <codecvt>
 #include <string_view>
 
@@ -374,6 +375,20 @@ Panel* Panel::update(const Input& input)
   return next;
 }
 
+namespace
+{
+// Spinning question mark frames
+constexpr Icon q_icons[]{Icon::ICON_QUESTION_1,
+                         Icon::ICON_QUESTION_2,
+                         Icon::ICON_QUESTION_4,
+                         Icon::ICON_QUESTION_3,
+                         Icon::ICON_QUESTION_1,
+                         Icon::ICON_QUESTION_3,
+                         Icon::ICON_QUESTION_4,
+                         Icon::ICON_QUESTION_2};
+constexpr bool q_flip[]{false, false, false, false, true, false, false, false};
+}  // namespace
+
 void Panel::draw(const SpriteManager& sprite_manager, Window& window) const
 {
   if (type_ == PanelType::PANEL_TYPE_PAGES)
@@ -395,6 +410,102 @@ void Panel::draw(const SpriteManager& sprite_manager, Window& window) const
   {
     window.fill_rect({frame_pos + geometry::Position(CHAR_W, CHAR_H), (frame_size + geometry::Size(1, 1)) * CHAR_W}, {0, 0, 0, 192});
   }
+
+  // The frame, text and sprites only change with the selected item, so they are drawn once to a cached surface
+  // Bounds cover the frame, its shadow and any sprites/icons
+  int x0 = frame_pos.x();
+  int y0 = frame_pos.y();
+  int x1 = frame_pos.x() + (frame_size.x() + 2) * CHAR_W;
+  int y1 = frame_pos.y() + (frame_size.y() + 2) * CHAR_H;
+  for (const auto& sprite : sprites_)
+  {
+    x0 = std::min(x0, sprite.second.x());
+    y0 = std::min(y0, sprite.second.y());
+    x1 = std::max(x1, sprite.second.x() + 16);
+    y1 = std::max(y1, sprite.second.y() + 16);
+  }
+  for (const auto& icon : icons_)
+  {
+    x0 = std::min(x0, icon.second.x());
+    y0 = std::min(y0, icon.second.y());
+    x1 = std::max(x1, icon.second.x() + CHAR_W);
+    y1 = std::max(y1, icon.second.y() + CHAR_H);
+  }
+  const geometry::Rectangle bounds{x0, y0, x1 - x0, y1 - y0};
+  if (!cache_)
+  {
+    cache_ = std::make_shared<Cache>();
+  }
+  if (!cache_->surface || cache_->index != index_ || cache_->remaster != sprite_manager.remaster)
+  {
+    if (!cache_->surface || cache_->surface->size() != bounds.size)
+    {
+      cache_->surface = window.create_target_surface(bounds.size);
+    }
+    if (cache_->surface)
+    {
+      auto* previous_target = window.get_render_target();
+      window.set_render_target(cache_->surface.get());
+      window.fill_rect({{0, 0}, bounds.size}, {0, 0, 0, 0});
+      draw_static(sprite_manager, frame_pos, frame_size, bounds.position);
+      window.set_render_target(previous_target);
+      cache_->index = index_;
+      cache_->remaster = sprite_manager.remaster;
+    }
+  }
+  if (cache_->surface)
+  {
+    window.blit_batched(*cache_->surface, {{0, 0}, bounds.size}, bounds);
+  }
+  else
+  {
+    draw_static(sprite_manager, frame_pos, frame_size, {0, 0});
+  }
+
+  const auto q_frame = (ticks_ / 2) % std::size(q_icons);
+
+  // Show spinning question mark at the selected menu item
+  if (!children_.empty() && children_[index_].first >= 0 && children_[index_].first < static_cast<int>(strings_.size()))
+  {
+    const auto row = children_[index_].first;
+    const auto first_char_idx = strings_[row].find_first_not_of(L" ");
+    if (first_char_idx != std::string::npos)
+    {
+      sprite_manager.render_icon(q_icons[q_frame],
+                                 frame_pos + geometry::Position(static_cast<int>(first_char_idx) * CHAR_W, (row + 2) * CHAR_H),
+                                 q_flip[q_frame]);
+    }
+  }
+
+  // Spinning question mark
+  if (question_pos_ != geometry::Position(0, 0))
+  {
+    auto pos = frame_pos + question_pos_;
+    // If there's input text, render it just before the question mark
+    if (!input_str_.empty())
+    {
+      std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> converter;
+      std::wstring panel_input = converter.from_bytes(input_str_);
+      Color tint{0xff, 0xff, 0xff};
+      pos = sprite_manager.render_text(panel_input, pos, tint);
+    }
+    sprite_manager.render_icon(q_icons[q_frame], pos, q_flip[q_frame]);
+  }
+
+  // Sparkle
+  const auto sparkle_frame = (ticks_ / 3) % (std::size(S_ICONS) + 1);
+  if (sparkle_frame > 0)
+  {
+    sprite_manager.render_icon(S_ICONS[sparkle_frame - 1], frame_pos + sparkle_pos_);
+  }
+}
+
+void Panel::draw_static(const SpriteManager& sprite_manager,
+                        geometry::Position frame_pos,
+                        const geometry::Size& frame_size,
+                        const geometry::Position& origin) const
+{
+  frame_pos -= origin;
   // Draw frame
   // Top-left corner
   sprite_manager.render_icon(Icon::ICON_FRAME_NW, frame_pos);
@@ -448,18 +559,6 @@ void Panel::draw(const SpriteManager& sprite_manager, Window& window) const
     }
   }
 
-  // Spinning question mark frame
-  constexpr Icon q_icons[]{Icon::ICON_QUESTION_1,
-                           Icon::ICON_QUESTION_2,
-                           Icon::ICON_QUESTION_4,
-                           Icon::ICON_QUESTION_3,
-                           Icon::ICON_QUESTION_1,
-                           Icon::ICON_QUESTION_3,
-                           Icon::ICON_QUESTION_4,
-                           Icon::ICON_QUESTION_2};
-  constexpr bool q_flip[]{false, false, false, false, true, false, false, false};
-  const auto q_frame = (ticks_ / 2) % std::size(q_icons);
-
   // Draw text
   int y = frame_pos.y() + 2 * CHAR_H;
   int x = frame_pos.x() + 2 * CHAR_W;
@@ -472,13 +571,6 @@ void Panel::draw(const SpriteManager& sprite_manager, Window& window) const
       if (children_[index_].first == row)
       {
         tint = {0xff, 0xff, 0x00};
-        // Show spinning question mark if this is the selected menu item
-        const auto first_char_idx = string.find_first_not_of(L" ");
-        if (first_char_idx != std::string::npos)
-        {
-          sprite_manager.render_icon(
-            q_icons[q_frame], geometry::Position(x + (static_cast<int>(first_char_idx) - 2) * CHAR_W, y), q_flip[q_frame]);
-        }
       }
       else
       {
@@ -501,36 +593,14 @@ void Panel::draw(const SpriteManager& sprite_manager, Window& window) const
     row++;
   }
 
-  // Spinning question mark
-  if (question_pos_ != geometry::Position(0, 0))
-  {
-    auto pos = frame_pos + question_pos_;
-    // If there's input text, render it just before the question mark
-    if (!input_str_.empty())
-    {
-      std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> converter;
-      std::wstring panel_input = converter.from_bytes(input_str_);
-      Color tint{0xff, 0xff, 0xff};
-      pos = sprite_manager.render_text(panel_input, pos, tint);
-    }
-    sprite_manager.render_icon(q_icons[q_frame], pos, q_flip[q_frame]);
-  }
-
-  // Sparkle
-  const auto sparkle_frame = (ticks_ / 3) % (std::size(S_ICONS) + 1);
-  if (sparkle_frame > 0)
-  {
-    sprite_manager.render_icon(S_ICONS[sparkle_frame - 1], frame_pos + sparkle_pos_);
-  }
-
   // Draw any sprites/icons in addition
   for (const auto& sprite : sprites_)
   {
-    sprite_manager.render_tile(sprite.first, sprite.second);
+    sprite_manager.render_tile(sprite.first, sprite.second, origin);
   }
   for (const auto& icon : icons_)
   {
-    sprite_manager.render_icon(icon.first, icon.second);
+    sprite_manager.render_icon(icon.first, icon.second - origin);
   }
 }
 
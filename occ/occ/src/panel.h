@@ -1,5 +1,7 @@
 #pragma once
 
+#include <memory>
+
 #include <event.h>
 
 #include "exe_data.h"
@@ -134,6 +136,12 @@ class Panel
   int index() const { return index_; }
 
  private:
+  // Draws the parts that don't change every frame, offset by -origin
+  void draw_static(const SpriteManager& sprite_manager,
+                   geometry::Position frame_pos,
+                   const geometry::Size& frame_size,
+                   const geometry::Position& origin) const;
+
   PanelType type_;
   std::vector<std::wstring> strings_;
   std::vector<std::pair<int, Panel>> children_;
@@ -147,4 +155,12 @@ class Panel
   unsigned ticks_ = 0;
   Panel* parent_ = nullptr;
   std::string input_str_ = "";
+  // Rendered frame, text and sprites; shared between copies of the panel, which have the same content
+  struct Cache
+  {
+    std::unique_ptr<Surface> surface;
+    int index = -1;
+    bool remaster = false;
+  };
+  mutable std::shared_ptr<Cache> cache_;
 };
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "chunked_grid.h"
+#include "geometry.h"
+#include "graphics.h"
+#include "level_id.h"
+#include "object.h"
+#include "player.h"
+#include "tile.h"
+
+/// Everything GameRenderer draws from one game tick, published by the simulation at the end of the tick
+/// Nothing in it points into the live Level, so drawing doesn't depend on what the simulation does next
+struct RenderSnapshot
+{
+  // The parts of the level the renderer reads
+  struct LevelState
+  {
+    LevelId level_id = LevelId::INTRO;
+    int width = 0;
+    int height = 0;
+    geometry::Position player_spawn;
+    bool show_player_controls = false;
+    bool space = false;
+    int recoil = 0;
+    // Shared with the level rather than copied, they don't change after loading
+    std::shared_ptr<const ChunkedGrid<Tile>> tiles;
+    std::shared_ptr<const ChunkedGrid<int>> bgs;
+
+    bool is_space() const { return space; }
+    const Tile& get_tile(const int x, const int y) const { return tiles->get(x, y); }
+    int get_bg(const int x, const int y) const { return bgs->get(x, y); }
+  };
+
+  struct EnemySprite
+  {
+    int sprite_id;
+    geometry::Position position;
+    bool bright;
+    // How far the enemy moved during the tick
+    geometry::Position motion;
+  };
+
+  unsigned game_tick = 0;
+
+  LevelState level;
+  // Level state that changes during the level
+  int switch_flags = 0;
+  int gravity = 0;
+  bool has_key = false;
+
+  geometry::Rectangle camera;
+  geometry::Position prev_camera_position;
+  unsigned game_complete_ticks = 0;
+
+  Player player;
+  std::vector<Object> objects;
+  // Sprites of the enemies near the camera
+  std::vector<EnemySprite> enemy_sprites;
+  // Enemy, hazard and detection areas in level coordinates, only collected in debug mode
+  std::vector<std::pair<geometry::Rectangle, Color>> debug_rectangles;
+
+  // HUD
+  unsigned score = 0;
+  unsigned num_ammo = 0;
+};
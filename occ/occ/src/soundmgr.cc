@@ -124,11 +124,23 @@ bool SoundManager::load_sounds(const int episode)
     auto& raw_chunk = raw_chunks_.emplace_back(to_raw(sound, spec_));
     chunks_.push_back(Mix_QuickLoad_RAW((Uint8*)raw_chunk.data(), (Uint32)raw_chunk.size()));
   }
+  last_played_.assign(chunks_.size(), 0);
   return !chunks_.empty();
 }
 
 void SoundManager::play_sound(const SoundType sound) const
 {
+  if (time_scale_ != 1)
+  {
+    static constexpr Uint32 SCALED_SOUND_INTERVAL_MS = 100;
+    const auto now = SDL_GetTicks();
+    auto& last_played = last_played_[static_cast<int>(sound)];
+    if (time_scale_ == 0 || (last_played != 0 && now - last_played < SCALED_SOUND_INTERVAL_MS))
+    {
+      return;
+    }
+    last_played = now;
+  }
   if (Mix_PlayChannel(-1, chunks_[static_cast<int>(sound)], 0) == -1)
   {
     LOG_CRITICAL("Could not play sound: %s", SDL_GetError());
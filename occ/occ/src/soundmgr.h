@@ -17,9 +17,14 @@ class SoundManager : public AbstractSoundManager
   bool load_sounds(const int episode);
   size_t size() const { return chunks_.size(); }
   virtual void play_sound(const SoundType sound) const override;
+  // When the game runs faster than real time each sound is played at most every SCALED_SOUND_INTERVAL_MS,
+  // and not at all when uncapped (0)
+  void set_time_scale(const unsigned scale) { time_scale_ = scale; }
 
  private:
   std::vector<std::string> raw_chunks_;
   std::vector<Mix_Chunk*> chunks_;
   SDL_AudioSpec spec_;
+  unsigned time_scale_ = 1;
+  mutable std::vector<Uint32> last_played_;
 };
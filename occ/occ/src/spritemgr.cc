@@ -3,6 +3,9 @@ https://moddingwiki.shikadi.net/wiki/ProGraphx_Toolbox_tileset_format
 */
 #include "spritemgr.h"
 
+#include <algorithm>
+#include <array>
+#include <charconv>
 #include <filesystem>
 #include <format>
 #include <fstream>
@@ -21,6 +24,10 @@ https://moddingwiki.shikadi.net/wiki/ProGraphx_Toolbox_tileset_format
 #define SPL_FILENAME_FMT "CC{}-SPL.MNI"
 #define FILLER 2
 #define CHAR_STRIDE 50
+#define TRANSPARENT_INDEX PALETTE_SIZE
+// First character of text cache keys
+#define TEXT_KEY L'T'
+#define NUMBER_KEY L'N'
 
 struct Header
 {
@@ -31,7 +38,8 @@ struct Header
   size_t size() const { return count * width * height * 5; }
 };
 
-const uint32_t colors[] = {
+// Palettes map each of the 16 EGA colour indices to an ARGB colour
+const Palette colors = {
   0xFF000000,  // "⚫",
   0xFF0000AA,  // "🔵",
   0xFF00AA00,  // "🟢",
@@ -50,80 +58,80 @@ const uint32_t colors[] = {
   0xFFFFFFFF,  // "⬜",
 };
 // Map all light colours to dark, and darks/greys to black
-const std::unordered_map<uint32_t, uint32_t> ega_dark = {
-  {0xFF000000, 0xFF000000},
-  {0xFF555555, 0xFF000000},
-  {0xFFAAAAAA, 0xFF000000},
-  {0xFFFFFFFF, 0xFFAAAAAA},
-  {0xFF0000AA, 0xFF000000},
-  {0xFF5555FF, 0xFF0000AA},
-  {0xFF00AA00, 0xFF000000},
-  {0xFF55FF55, 0xFF00AA00},
-  {0xFF00AAAA, 0xFF000000},
-  {0xFF55FFFF, 0xFF00AAAA},
-  {0xFFAA0000, 0xFF000000},
-  {0xFFFF5555, 0xFFAA0000},
-  {0xFFAA00AA, 0xFF000000},
-  {0xFFFF55FF, 0xFFAA00AA},
-  {0xFFAA5500, 0xFF000000},
-  {0xFFFFFF55, 0xFFAA5500},
+const Palette ega_dark = {
+  0xFF000000,
+  0xFF000000,
+  0xFF000000,
+  0xFF000000,
+  0xFF000000,
+  0xFF000000,
+  0xFF000000,
+  0xFF000000,
+  0xFF000000,
+  0xFF0000AA,
+  0xFF00AA00,
+  0xFF00AAAA,
+  0xFFAA0000,
+  0xFFAA00AA,
+  0xFFAA5500,
+  0xFFAAAAAA,
 };
 // Blue night palette https://lospec.com/palette-list/blue-night
-const std::unordered_map<uint32_t, uint32_t> blue_night = {
-  {0xFF000000, 0xFF000000},
-  {0xFF555555, 0xFF050526},
-  {0xFFAAAAAA, 0xFF12073e},
-  {0xFFFFFFFF, 0xFF4576a3},
-  {0xFF0000AA, 0xFF000000},
-  {0xFF5555FF, 0xFF12073e},
-  {0xFF00AA00, 0xFF000000},
-  {0xFF55FF55, 0xFF201254},
-  {0xFF00AAAA, 0xFF000000},
-  {0xFF55FFFF, 0xFF241b67},
-  {0xFFAA0000, 0xFF000000},
-  {0xFFFF5555, 0xFF241b67},
-  {0xFFAA00AA, 0xFF000000},
-  {0xFFFF55FF, 0xFF242472},
-  {0xFFAA5500, 0xFF000000},
-  {0xFFFFFF55, 0xFF242472},
+const Palette blue_night = {
+  0xFF000000,
+  0xFF000000,
+  0xFF000000,
+  0xFF000000,
+  0xFF000000,
+  0xFF000000,
+  0xFF000000,
+  0xFF12073e,
+  0xFF050526,
+  0xFF12073e,
+  0xFF201254,
+  0xFF241b67,
+  0xFF241b67,
+  0xFF242472,
+  0xFF242472,
+  0xFF4576a3,
 };
 // Map all non-black colours to white
-const std::unordered_map<uint32_t, uint32_t> ega_white = {
-  {0xFF000000, 0xFF000000},
-  {0xFF555555, 0xFFFFFFFF},
-  {0xFFAAAAAA, 0xFFFFFFFF},
-  {0xFFFFFFFF, 0xFFFFFFFF},
-  {0xFF0000AA, 0xFFFFFFFF},
-  {0xFF5555FF, 0xFFFFFFFF},
-  {0xFF00AA00, 0xFFFFFFFF},
-  {0xFF55FF55, 0xFFFFFFFF},
-  {0xFF00AAAA, 0xFFFFFFFF},
-  {0xFF55FFFF, 0xFFFFFFFF},
-  {0xFFAA0000, 0xFFFFFFFF},
-  {0xFFFF5555, 0xFFFFFFFF},
-  {0xFFAA00AA, 0xFFFFFFFF},
-  {0xFFFF55FF, 0xFFFFFFFF},
-  {0xFFAA5500, 0xFFFFFFFF},
-  {0xFFFFFF55, 0xFFFFFFFF},
+const Palette ega_white = {
+  0xFF000000,
+  0xFFFFFFFF,
+  0xFFFFFFFF,
+  0xFFFFFFFF,
+  0xFFFFFFFF,
+  0xFFFFFFFF,
+  0xFFFFFFFF,
+  0xFFFFFFFF,
+  0xFFFFFFFF,
+  0xFFFFFFFF,
+  0xFFFFFFFF,
+  0xFFFFFFFF,
+  0xFFFFFFFF,
+  0xFFFFFFFF,
+  0xFFFFFFFF,
+  0xFFFFFFFF,
 };
 // Bright palette (https://lospec.com/palette-list/peelyweelybananyicecreamy + https://lospec.com/palette-list/cherry-blossom-gb)
-const std::unordered_map<uint32_t, uint32_t> banana_cherry = {
-  {0xFF000000, 0xFF000000},
-  {0xFF555555, 0xFFC48533},
-  {0xFFAAAAAA, 0xFFE0983A},
-  {0xFFFFFFFF, 0xFFFFFFFF},
-  {0xFF0000AA, 0xFFE2E298},
-  {0xFF5555FF, 0xFFFFD3E1},
-  {0xFF00AA00, 0xFFFFFFAA},
-  {0xFF55FF55, 0xFFFFFFAA},
-  {0xFF00AAAA, 0xFFFFFFD3},
-  {0xFF55FFFF, 0xFFFFD3E1},
-  {0xFFAA0000, 0xFFFFEFFE},
-  {0xFFFF5555, 0xFFFFD3E1},
-  {0xFFAA00AA, 0xFFE2C298},
-  {0xFFFF55FF, 0xFFFFEFFE},
-  {0xFFAA5500, 0xFFE0A659},
-  {0xFFFFFF55, 0xFFFFFFE8},
+const Palette banana_cherry = {
+  0xFF000000,
+  0xFFE2E298,
+  0xFFFFFFAA,
+  0xFFFFFFD3,
+  0xFFFFEFFE,
+  0xFFE2C298,
+  0xFFE0A659,
+  0xFFE0983A,
+  0xFFC48533,
+  0xFFFFD3E1,
+  0xFFFFFFAA,
+  0xFFFFD3E1,
+  0xFFFFD3E1,
+  0xFFFFEFFE,
+  0xFFFFFFE8,
+  0xFFFFFFFF,
 };
 
 int read_sprite_count(std::ifstream& input, const int filler)
@@ -150,13 +158,13 @@ int read_sprite_count(std::ifstream& input, const int filler)
   return count;
 }
 
-std::string load_pixels(const std::filesystem::path& path,
-                        const int sprite_w,
-                        const int sprite_h,
-                        const int stride,
-                        const int filler,
-                        int& sheet_w,
-                        int& sheet_h)
+std::vector<uint8_t> load_pixels(const std::filesystem::path& path,
+                                 const int sprite_w,
+                                 const int sprite_h,
+                                 const int stride,
+                                 const int filler,
+                                 int& sheet_w,
+                                 int& sheet_h)
 {
   LOG_DEBUG("Reading %s...", path.c_str());
   std::ifstream input{path, std::ios::binary};
@@ -164,11 +172,12 @@ std::string load_pixels(const std::filesystem::path& path,
   if (count == 0)
   {
     LOG_CRITICAL("Could not load any sprites!");
-    return "";
+    return {};
   }
   sheet_w = stride * sprite_w;
   sheet_h = math::round_up(count * sprite_h / stride, sprite_h);
-  std::string all_pixels(sheet_w * sheet_h * sizeof(uint32_t), '\0');
+  // Keep the palette index per pixel; colours are only applied when building a palette variant
+  std::vector<uint8_t> all_pixels(sheet_w * sheet_h, TRANSPARENT_INDEX);
   Header header;
   int index = 0;
   while (input.read(reinterpret_cast<char*>(&header), sizeof header))
@@ -200,18 +209,13 @@ std::string load_pixels(const std::filesystem::path& path,
             {
               const bool t = (t_plane >> bit) & 1;
               const int pixel_i = x + y * stride * sprite_h;
-              if (!t)
-              {
-                ((uint32_t*)all_pixels.data())[pixel_i] = 0;
-              }
-              else
+              if (t)
               {
                 const int b = (b_plane >> bit) & 1;
                 const int g = (g_plane >> bit) & 1;
                 const int r = (r_plane >> bit) & 1;
                 const int i = (i_plane >> bit) & 1;
-                const int color_index = (i << 3) | (r << 2) | (g << 1) | b;
-                ((uint32_t*)all_pixels.data())[pixel_i] = colors[color_index];
+                all_pixels[pixel_i] = static_cast<uint8_t>((i << 3) | (r << 2) | (g << 1) | b);
               }
               x++;
               if (x == x_start + sprite_w)
@@ -239,10 +243,9 @@ std::string load_pixels(const std::filesystem::path& path,
         for (int x = 0; x < sprite_w; x++)
         {
           const int pixel_i = x + x_start + (y + y_start) * stride * sprite_h;
-          uint32_t* pixel = &((uint32_t*)all_pixels.data())[pixel_i];
-          if (*pixel == colors[0])
+          if (all_pixels[pixel_i] == 0)
           {
-            *pixel = 0;
+            all_pixels[pixel_i] = TRANSPARENT_INDEX;
           }
         }
       }
@@ -262,11 +265,9 @@ std::string load_pixels(const std::filesystem::path& path,
         {
           const int bg_pixel_i = x + bg_x_start + (y + bg_y_start) * stride * sprite_h;
           const int h_pixel_i = x + h_x_start + (y + h_y_start) * stride * sprite_h;
-          const uint32_t bg_pixel = ((uint32_t*)all_pixels.data())[bg_pixel_i];
-          uint32_t* h_pixel = &((uint32_t*)all_pixels.data())[h_pixel_i];
-          if (*h_pixel == bg_pixel)
+          if (all_pixels[h_pixel_i] == all_pixels[bg_pixel_i])
           {
-            *h_pixel = 0;
+            all_pixels[h_pixel_i] = TRANSPARENT_INDEX;
           }
         }
       }
@@ -275,72 +276,37 @@ std::string load_pixels(const std::filesystem::path& path,
   return all_pixels;
 }
 
-std::string swap_pixels(const std::string& in, const std::unordered_map<uint32_t, uint32_t>& mapping)
+void apply_palette(const std::vector<uint8_t>& indices, const Palette& palette, uint32_t* out)
 {
-  // Palette swap pixels
-  std::string out(in.length(), '\0');
-  for (int i = 0; i < static_cast<int>(in.length()) / static_cast<int>(sizeof(uint32_t)); i++)
+  // 17-entry lookup table: the palette colours plus a fully transparent entry for TRANSPARENT_INDEX
+  std::array<uint32_t, PALETTE_SIZE + 1> lut{};
+  std::copy(palette.cbegin(), palette.cend(), lut.begin());
+  const uint8_t* in = indices.data();
+  const size_t count = indices.size();
+  for (size_t i = 0; i < count; i++)
   {
-    const uint32_t pixel_in = reinterpret_cast<const uint32_t*>(in.data())[i];
-    uint32_t* pixel_out = &reinterpret_cast<uint32_t*>(out.data())[i];
-    const int a = pixel_in & 0xff000000;
-    const auto mapped = mapping.find(pixel_in);
-    if (a == 0 || mapped == mapping.end())
-    {
-      *pixel_out = 0;
-    }
-    else
-    {
-      *pixel_out = mapped->second;
-    }
+    out[i] = lut[in[i]];
   }
-  return out;
 }
 
-std::unique_ptr<Surface> load_surface(const std::filesystem::path& path,
-                                      Window& window,
-                                      const int sprite_w,
-                                      const int sprite_h,
-                                      const int stride,
-                                      const int filler)
+std::unique_ptr<Surface> load_surface(const std::vector<uint8_t>& indices,
+                                      const int sheet_w,
+                                      const int sheet_h,
+                                      const std::pair<std::string, Palette>& palette,
+                                      Window& window)
 {
-  if (path.empty())
-  {
-    LOG_CRITICAL("Could not find game data!");
-    return nullptr;
-  }
-  int sheet_w = 0, sheet_h = 0;
-  const auto one_pixels = load_pixels(path, sprite_w, sprite_h, stride, filler, sheet_w, sheet_h);
-  if (one_pixels.empty())
-  {
-    return nullptr;
-  }
-  // Duplicate the pixels and recolour/map them
-  // The surfaces are now stacked vertically:
-  // - normal
-  // - EGA dark
-  // - EGA white
-  // - Blue Night
-  // - Banana Cherry
-  const auto all_pixels = one_pixels + swap_pixels(one_pixels, ega_dark) + swap_pixels(one_pixels, ega_white) +
-    swap_pixels(one_pixels, blue_night) + swap_pixels(one_pixels, banana_cherry);
-  sheet_h *= 5;
-  auto surface = Surface::from_pixels(sheet_w, sheet_h, (uint32_t*)all_pixels.data(), window);
+  // Recolour the indexed pixels with the palette
+  std::vector<uint32_t> pixels(indices.size());
+  apply_palette(indices, palette.second, pixels.data());
+  auto surface = Surface::from_pixels(sheet_w, sheet_h, pixels.data(), window);
   if (!surface)
   {
-    LOG_CRITICAL("Could not load '%s'", path.c_str());
+    LOG_CRITICAL("Could not create sprite surface for palette '%s'", palette.first.c_str());
   }
   return surface;
 }
 
-std::unique_ptr<Surface> load_tiles(Window& window, const int episode)
-{
-  // Load tileset
-  const auto path = get_data_path(std::format(GFX_FILENAME_FMT, episode));
-  return load_surface(path, window, SPRITE_W, SPRITE_H, SPRITE_STRIDE, FILLER);
-}
-
-bool try_load_char_pixels(const std::filesystem::path& path, std::string& all_pixels, int& all_sheet_w, int& all_sheet_h)
+bool try_load_char_pixels(const std::filesystem::path& path, std::vector<uint8_t>& all_pixels, int& all_sheet_w, int& all_sheet_h)
 {
   if (path.empty())
   {
@@ -352,16 +318,16 @@ bool try_load_char_pixels(const std::filesystem::path& path, std::string& all_pi
   {
     return false;
   }
-  all_pixels += pixels;
+  all_pixels.insert(all_pixels.end(), pixels.cbegin(), pixels.cend());
   all_sheet_w = sheet_w;
   all_sheet_h += sheet_h;
   return true;
 }
 
-std::unique_ptr<Surface> load_chars(Window& window, const int episode)
+std::unique_ptr<Image> load_chars(const int episode)
 {
   // Load fonts/characters
-  std::string all_pixels = "";
+  std::vector<uint8_t> all_pixels;
   int all_sheet_w = 0;
   int all_sheet_h = 0;
   for (int i = 1;; i++)
@@ -379,33 +345,74 @@ std::unique_ptr<Surface> load_chars(Window& window, const int episode)
     LOG_CRITICAL("Could not load font files");
     return nullptr;
   }
-  auto surface = Surface::from_pixels(all_sheet_w, all_sheet_h, (uint32_t*)all_pixels.data(), window);
-  if (!surface)
+  std::vector<uint32_t> argb_pixels(all_pixels.size());
+  apply_palette(all_pixels, colors, argb_pixels.data());
+  auto image = Image::from_pixels(all_sheet_w, all_sheet_h, argb_pixels.data());
+  if (!image)
   {
-    LOG_CRITICAL("Could not load font surface");
+    LOG_CRITICAL("Could not load font image");
   }
-  return surface;
+  return image;
+}
+
+SpriteManager::SpriteManager()
+  : palettes_({
+      {"normal", colors},
+      {"ega_dark", ega_dark},
+      {"ega_white", ega_white},
+      {"blue_night", blue_night},
+      {"banana_cherry", banana_cherry},
+    }),
+    palette_surfaces_(palettes_.size()),
+    palette_used_(palettes_.size(), false),
+    char_surface_(),
+    other_surfaces_()
+{
+  // Generate random indices for the Kilroy and Winners signs, which are used in the remaster mode
+  kilroy_sign_index_ = static_cast<int>(rand() % 3);
+  winners_sign_index_ = static_cast<int>(rand() % 4);
 }
 
 bool SpriteManager::load_tilesets(Window& window, const int episode)
 {
-  if (!sprite_surface_)
+  return decode_tilesets(episode) && upload_tilesets(window);
+}
+
+bool SpriteManager::load_tilesets(Window& window, std::vector<uint8_t> sprite_indices, const int sheet_w, const int sheet_h)
+{
+  sprite_indices_ = std::move(sprite_indices);
+  sprite_sheet_w_ = sheet_w;
+  sprite_sheet_h_ = sheet_h;
+  char_surface_ = load_surface(sprite_indices_, sheet_w, sheet_h, palettes_[PALETTE_NORMAL], window);
+  return char_surface_ && upload_tilesets(window);
+}
+
+bool SpriteManager::decode_tilesets(const int episode)
+{
+  if (sprite_indices_.empty())
   {
-    sprite_surface_ = load_tiles(window, episode);
-    if (!sprite_surface_)
+    // Load tileset
+    const auto path = get_data_path(std::format(GFX_FILENAME_FMT, episode));
+    if (path.empty())
+    {
+      LOG_CRITICAL("Could not find game data!");
+      return false;
+    }
+    sprite_indices_ = load_pixels(path, SPRITE_W, SPRITE_H, SPRITE_STRIDE, FILLER, sprite_sheet_w_, sprite_sheet_h_);
+    if (sprite_indices_.empty())
     {
       return false;
     }
   }
-  if (!char_surface_)
+  if (!char_surface_ && !char_image_)
   {
-    char_surface_ = load_chars(window, episode);
-    if (!char_surface_)
+    char_image_ = load_chars(episode);
+    if (!char_image_)
     {
       return false;
     }
   }
-  if (other_surfaces_.empty())
+  if (other_surfaces_.empty() && other_images_.empty())
   {
     const std::vector<std::string> names = {
       "key_left",
@@ -424,35 +431,138 @@ bool SpriteManager::load_tilesets(Window& window, const int episode)
     for (const auto& name : names)
     {
       const auto path = get_data_path("../" + name + ".png");
-      auto surface = Surface::from_image(path, window);
-      if (!surface)
+      auto image = Image::from_image(path);
+      if (!image)
       {
         return false;
       }
-      other_surfaces_[name] = std::move(surface);
+      other_images_[name] = std::move(image);
+    }
+  }
+
+  return true;
+}
+
+bool SpriteManager::upload_tilesets(Window& window)
+{
+  window_ = &window;
+  if (!palette_surfaces_[PALETTE_NORMAL])
+  {
+    if (sprite_indices_.empty())
+    {
+      LOG_CRITICAL("Tileset has not been decoded");
+      return false;
+    }
+    // Only the normal palette is created up front, the other variants are created on first use
+    palette_surfaces_[PALETTE_NORMAL] = load_surface(sprite_indices_, sprite_sheet_w_, sprite_sheet_h_, palettes_[PALETTE_NORMAL], window);
+    if (!palette_surfaces_[PALETTE_NORMAL])
+    {
+      return false;
+    }
+  }
+  if (!char_surface_)
+  {
+    if (!char_image_)
+    {
+      LOG_CRITICAL("Font has not been decoded");
+      return false;
+    }
+    char_surface_ = Surface::from_image_data(*char_image_, window);
+    if (!char_surface_)
+    {
+      LOG_CRITICAL("Could not load font surface");
+      return false;
     }
+    char_image_.reset();
   }
+  for (const auto& [name, image] : other_images_)
+  {
+    auto surface = Surface::from_image_data(*image, window);
+    if (!surface)
+    {
+      return false;
+    }
+    other_surfaces_[name] = std::move(surface);
+  }
+  other_images_.clear();
 
   return true;
 }
 
-const Surface* SpriteManager::get_surface() const
+int SpriteManager::register_palette(const std::string& name, const Palette& palette)
+{
+  const int id = get_palette_id(name);
+  if (id >= 0)
+  {
+    palettes_[id].second = palette;
+    // Recreate the variant with the new colours on next use
+    palette_surfaces_[id].reset();
+    return id;
+  }
+  palettes_.emplace_back(name, palette);
+  palette_surfaces_.emplace_back();
+  palette_used_.push_back(false);
+  return static_cast<int>(palettes_.size()) - 1;
+}
+
+int SpriteManager::get_palette_id(const std::string& name) const
 {
-  return sprite_surface_.get();
+  const auto it = std::find_if(palettes_.cbegin(), palettes_.cend(), [&name](const auto& p) { return p.first == name; });
+  if (it == palettes_.cend())
+  {
+    return -1;
+  }
+  return static_cast<int>(it - palettes_.cbegin());
+}
+
+int SpriteManager::palette_count() const
+{
+  return static_cast<int>(palettes_.size());
+}
+
+void SpriteManager::release_unused_palettes()
+{
+  for (size_t i = 0; i < palette_surfaces_.size(); i++)
+  {
+    // The normal palette is always kept, it is needed for e.g. get_rect_for_tile
+    if (i != PALETTE_NORMAL && !palette_used_[i] && palette_surfaces_[i])
+    {
+      LOG_DEBUG("Releasing unused palette '%s'", palettes_[i].first.c_str());
+      palette_surfaces_[i].reset();
+    }
+    palette_used_[i] = false;
+  }
+}
+
+const Surface* SpriteManager::get_surface(const int palette) const
+{
+  if (palette < 0 || palette >= palette_count())
+  {
+    LOG_ERROR("Invalid palette %d", palette);
+    return palette_surfaces_[PALETTE_NORMAL].get();
+  }
+  palette_used_[palette] = true;
+  if (!palette_surfaces_[palette] && window_)
+  {
+    palette_surfaces_[palette] = load_surface(sprite_indices_, sprite_sheet_w_, sprite_sheet_h_, palettes_[palette], *window_);
+    if (!palette_surfaces_[palette])
+    {
+      return palette_surfaces_[PALETTE_NORMAL].get();
+    }
+  }
+  return palette_surfaces_[palette].get();
 }
 
 geometry::Rectangle SpriteManager::get_rect_for_tile(const int sprite) const
 {
-  return {(sprite % (sprite_surface_->width() / SPRITE_W)) * SPRITE_W,
-          (sprite / (sprite_surface_->width() / SPRITE_H)) * SPRITE_H,
-          SPRITE_W,
-          SPRITE_H};
+  return {(sprite % (sprite_sheet_w_ / SPRITE_W)) * SPRITE_W, (sprite / (sprite_sheet_w_ / SPRITE_H)) * SPRITE_H, SPRITE_W, SPRITE_H};
 }
 
 void SpriteManager::render_tile(const int sprite,
                                 const geometry::Position& pos,
                                 const geometry::Position camera_position,
-                                const Color color) const
+                                const Color color,
+                                const int palette) const
 {
   if (sprite == static_cast<int>(Sprite::SPRITE_CONES))
   {
@@ -479,11 +589,19 @@ void SpriteManager::render_tile(const int sprite,
     }
   }
 
-  // Use alternate sprites for remaster gfx
-  const int sprite_remaster = remaster && sprite >= SPRITE_TOTAL ? sprite + SPRITE_TOTAL * 2 : sprite;
-  const auto src_rect = get_rect_for_tile(sprite_remaster);
+  // Use alternate palettes for remaster gfx
+  int palette_remaster = palette;
+  if (remaster && palette == PALETTE_EGA_DARK)
+  {
+    palette_remaster = PALETTE_BLUE_NIGHT;
+  }
+  else if (remaster && palette == PALETTE_EGA_WHITE)
+  {
+    palette_remaster = PALETTE_BANANA_CHERRY;
+  }
+  const auto src_rect = get_rect_for_tile(sprite);
   const geometry::Rectangle dest_rect{pos.x() - camera_position.x(), pos.y() - camera_position.y(), SPRITE_W, SPRITE_H};
-  get_surface()->blit_surface(src_rect, dest_rect, false, color);
+  window_->blit_batched(*get_surface(palette_remaster), src_rect, dest_rect, false, color);
 }
 
 const Surface* SpriteManager::get_char_surface() const
@@ -493,34 +611,28 @@ const Surface* SpriteManager::get_char_surface() const
 
 geometry::Rectangle SpriteManager::get_rect_for_char(const wchar_t ch) const
 {
-  int idx = char_map.find(L' ')->second;
-  if (auto search = char_map.find(ch); search != char_map.end())
-  {
-    idx = search->second;
-  }
-  return get_rect_for_icon(idx);
+  return get_rect_for_icon(get_char_index(ch));
 }
 
 geometry::Position SpriteManager::render_text(const std::wstring& text, const geometry::Position& pos, const Color tint) const
 {
-  int x = pos.x();
+  // Render line by line so each line is one cached surface
   int y = pos.y();
-  for (const auto& ch : text)
+  size_t start = 0;
+  while (true)
   {
-    if (ch == L'\n')
+    const auto end = text.find(L'\n', start);
+    const auto length = (end == std::wstring::npos ? text.size() : end) - start;
+    text_key_.assign(1, TEXT_KEY);
+    text_key_.append(text, start, length);
+    render_glyphs(text_key_, {pos.x(), y}, tint);
+    if (end == std::wstring::npos)
     {
-      x = pos.x();
-      y += CHAR_H;
-    }
-    else
-    {
-      const auto src_rect = get_rect_for_char(ch);
-      const geometry::Rectangle dest_rect{x, y, CHAR_W, CHAR_H};
-      get_char_surface()->blit_surface(src_rect, dest_rect, false, tint);
-      x += CHAR_W;
+      return Vector<int>(pos.x() + static_cast<int>(length) * CHAR_W, y);
     }
+    y += CHAR_H;
+    start = end + 1;
   }
-  return Vector<int>(x, y);
 }
 
 void SpriteManager::render_other(const std::string& name, const geometry::Position& pos, const geometry::Position camera_position) const
@@ -532,7 +644,7 @@ void SpriteManager::render_other(const std::string& name, const geometry::Positi
   }
   const auto surface = it->second.get();
   const geometry::Rectangle dest_rect{pos.x() - camera_position.x(), pos.y() - camera_position.y(), surface->width(), surface->height()};
-  surface->blit_surface({0, 0, surface->width(), surface->height()}, dest_rect);
+  window_->blit_batched(*surface, {0, 0, surface->width(), surface->height()}, dest_rect);
 }
 
 void SpriteManager::render_sign(const std::string& name,
@@ -548,7 +660,7 @@ void SpriteManager::render_sign(const std::string& name,
   const auto surface = it->second.get();
   const geometry::Rectangle src_rect{0, i * 16, surface->width(), 16};
   const geometry::Rectangle dest_rect{pos.x() - camera_position.x(), pos.y() - camera_position.y(), surface->width(), 16};
-  surface->blit_surface(src_rect, dest_rect);
+  window_->blit_batched(*surface, src_rect, dest_rect);
 }
 
 geometry::Rectangle SpriteManager::get_rect_for_number(const char ch) const
@@ -558,18 +670,51 @@ geometry::Rectangle SpriteManager::get_rect_for_number(const char ch) const
 
 geometry::Position SpriteManager::render_number(const int num, const geometry::Position& pos) const
 {
-  const auto text = std::to_string(num);
+  std::array<char, 16> digits;
+  const auto result = std::to_chars(digits.data(), digits.data() + digits.size(), num);
+  const auto length = static_cast<int>(result.ptr - digits.data());
+  text_key_.assign(1, NUMBER_KEY);
+  text_key_.append(digits.data(), result.ptr);
   // Numbers are right-aligned
-  int x = pos.x() - CHAR_W;
-  // Iterate in reverse due to right align
-  for (auto it = text.crbegin(); it != text.crend(); ++it)
+  render_glyphs(text_key_, {pos.x() - length * CHAR_W, pos.y()}, {0xff, 0xff, 0xff});
+  return Vector<int>(pos.x() - (length + 1) * CHAR_W, pos.y());
+}
+
+void SpriteManager::render_glyphs(const std::wstring& key, const geometry::Position& pos, const Color tint) const
+{
+  const int length = static_cast<int>(key.size()) - 1;
+  if (length <= 0 || !char_surface_ || !window_)
+  {
+    return;
+  }
+  const auto get_rect = [this, number = key[0] == NUMBER_KEY](const wchar_t ch)
+  { return number ? get_rect_for_number(static_cast<char>(ch)) : get_rect_for_char(ch); };
+  const geometry::Size size{length * CHAR_W, CHAR_H};
+
+  const Surface* surface = text_cache_.find(key);
+  if (!surface)
   {
-    const auto src_rect = get_rect_for_number(*it);
-    const geometry::Rectangle dest_rect{x, pos.y(), CHAR_W, CHAR_H};
-    get_char_surface()->blit_surface(src_rect, dest_rect);
-    x -= CHAR_W;
+    auto* new_surface = text_cache_.insert(*window_, key, size);
+    if (!new_surface)
+    {
+      // Draw the glyphs directly instead
+      for (int i = 0; i < length; i++)
+      {
+        window_->blit_batched(*char_surface_, get_rect(key[i + 1]), {pos.x() + i * CHAR_W, pos.y(), CHAR_W, CHAR_H}, false, tint);
+      }
+      return;
+    }
+    auto* previous_target = window_->get_render_target();
+    window_->set_render_target(new_surface);
+    window_->fill_rect({{0, 0}, new_surface->size()}, {0, 0, 0, 0});
+    for (int i = 0; i < length; i++)
+    {
+      window_->blit_batched(*char_surface_, get_rect(key[i + 1]), {i * CHAR_W, 0, CHAR_W, CHAR_H});
+    }
+    window_->set_render_target(previous_target);
+    surface = new_surface;
   }
-  return Vector<int>(x, pos.y());
+  window_->blit_batched(*surface, {{0, 0}, size}, {pos, size}, false, tint);
 }
 
 geometry::Rectangle SpriteManager::get_rect_for_icon(const int idx) const
@@ -581,5 +726,5 @@ void SpriteManager::render_icon(const Icon icon, const geometry::Position& pos,
 {
   const auto src_rect = get_rect_for_icon(static_cast<int>(icon));
   const geometry::Rectangle dest_rect{pos.x(), pos.y(), CHAR_W, CHAR_H};
-  get_char_surface()->blit_surface(src_rect, dest_rect, flip, tint);
+  window_->blit_batched(*get_char_surface(), src_rect, dest_rect, flip, tint);
 }
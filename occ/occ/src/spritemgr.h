@@ -1,15 +1,31 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "geometry.h"
 #include "graphics.h"
+#include "text_cache.h"
 
 // TODO: Rename files to sprite_manager.cc/h ?
 #define CHAR_W 8
 #define CHAR_H 8
+#define PALETTE_SIZE 16
+
+// ARGB colour for each of the 16 EGA colour indices
+using Palette = std::array<uint32_t, PALETTE_SIZE>;
+
+// Built-in palettes; more can be added with SpriteManager::register_palette
+constexpr int PALETTE_NORMAL = 0;
+constexpr int PALETTE_EGA_DARK = 1;
+constexpr int PALETTE_EGA_WHITE = 2;
+constexpr int PALETTE_BLUE_NIGHT = 3;
+constexpr int PALETTE_BANANA_CHERRY = 4;
 
 enum class Icon : int
 {
@@ -41,20 +57,31 @@ enum class Icon : int
 class SpriteManager
 {
  public:
-  SpriteManager() : sprite_surface_(), char_surface_(), other_surfaces_()
-  {
-    // Generate random indices for the Kilroy and Winners signs, which are used in the remaster mode
-    kilroy_sign_index_ = static_cast<int>(rand() % 3);
-    winners_sign_index_ = static_cast<int>(rand() % 4);
-  }
+  SpriteManager();
 
+  // Same as decode_tilesets followed by upload_tilesets
   bool load_tilesets(Window& window, const int episode);
-  const Surface* get_surface() const;
+  // Reads the tileset, fonts and images into CPU memory; does not need the Window so it can run on a worker thread
+  bool decode_tilesets(const int episode);
+  // Creates the surfaces from the decoded tilesets; must be called on the main thread
+  bool upload_tilesets(Window& window);
+  // Uses the given palette indices as the tileset, and the tileset as the font, instead of the episode's files
+  // For rendering without the game data, e.g. in golden frame tests
+  bool load_tilesets(Window& window, std::vector<uint8_t> sprite_indices, const int sheet_w, const int sheet_h);
+  // Adds (or replaces) a named palette and returns its id
+  int register_palette(const std::string& name, const Palette& palette);
+  // Returns -1 if there is no palette with that name
+  int get_palette_id(const std::string& name) const;
+  int palette_count() const;
+  // Releases the palette surfaces that have not been used since the last call; they are recreated on demand
+  void release_unused_palettes();
+  const Surface* get_surface(const int palette = PALETTE_NORMAL) const;
   geometry::Rectangle get_rect_for_tile(const int sprite) const;
   void render_tile(const int sprite,
                    const geometry::Position& pos,
                    const geometry::Position camera_position = {0, 0},
-                   const Color color = {0xff, 0xff, 0xff}) const;
+                   const Color color = {0xff, 0xff, 0xff},
+                   const int palette = PALETTE_NORMAL) const;
   const Surface* get_char_surface() const;
   geometry::Rectangle get_rect_for_char(const wchar_t ch) const;
   geometry::Position render_text(const std::wstring& text, const geometry::Position& pos, const Color tint = {0xff, 0xff, 0xff}) const;
@@ -71,9 +98,24 @@ class SpriteManager
   bool remaster = true;
 
  private:
-  std::unique_ptr<Surface> sprite_surface_;
+  // key is a kind character (TEXT_KEY or NUMBER_KEY) followed by the characters of one line
+  void render_glyphs(const std::wstring& key, const geometry::Position& pos, const Color tint) const;
+
+  // Palette index per sprite sheet pixel, used to create the palette surfaces on demand
+  std::vector<uint8_t> sprite_indices_;
+  int sprite_sheet_w_ = 0;
+  int sprite_sheet_h_ = 0;
+  std::vector<std::pair<std::string, Palette>> palettes_;
+  mutable std::vector<std::unique_ptr<Surface>> palette_surfaces_;
+  mutable std::vector<bool> palette_used_;
+  Window* window_ = nullptr;
   std::unique_ptr<Surface> char_surface_;
   std::unordered_map<std::string, std::unique_ptr<Surface>> other_surfaces_;
+  // Decoded but not yet uploaded
+  std::unique_ptr<Image> char_image_;
+  std::unordered_map<std::string, std::unique_ptr<Image>> other_images_;
+  mutable TextCache text_cache_;
+  mutable std::wstring text_key_;
   int kilroy_sign_index_;
   int winners_sign_index_;
 };
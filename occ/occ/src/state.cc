@@ -134,17 +134,22 @@ void SkipState::update(const Input& input)
   }
 }
 
-SplashState::SplashState(SoundManager& sound_manager, std::vector<Surface*>& images, Window& window)
+SplashState::SplashState(const int episode, SoundManager& sound_manager, ImageManager& image_manager, Window& window)
   : State(FADE_IN_TICKS, 0, window),
     sound_manager_(sound_manager),
-    images_(images)
+    image_manager_(image_manager),
+    episode_(episode)
 {
 }
 
 void SplashState::draw(Window& window) const
 {
-  images_[0]->blit_surface(geometry::Rectangle(0, 0, images_[0]->size()),
-                           geometry::Rectangle((WINDOW_SIZE - CAMERA_SIZE_SCALED) / 2, CAMERA_SIZE_SCALED));
+  const auto& images = image_manager_.get_images(episode_, CCImage::IMAGE_APOGEE);
+  if (!images.empty())
+  {
+    images[0]->blit_surface(geometry::Rectangle(0, 0, images[0]->size()),
+                            geometry::Rectangle((WINDOW_SIZE - CAMERA_SIZE_SCALED) / 2, CAMERA_SIZE_SCALED));
+  }
   State::draw(window);
 }
 
@@ -166,7 +171,7 @@ TitleState::TitleState(const int episode,
                        SpriteManager& sprite_manager,
                        SoundManager& sound_manager,
                        Surface& game_surface,
-                       std::vector<Surface*>& images,
+                       ImageManager& image_manager,
                        Window& window,
                        ExeData& exe_data,
                        PlayerState& player_state)
@@ -174,7 +179,9 @@ TitleState::TitleState(const int episode,
     sprite_manager_(sprite_manager),
     sound_manager_(sound_manager),
     game_surface_(game_surface),
-    images_(images),
+    image_manager_(image_manager),
+    episode_(episode),
+    images_(),
     player_state_(player_state),
     panel_(
       // TODO: add options menu here
@@ -296,14 +303,28 @@ void TitleState::update(const Input& input)
   }
 }
 
+void TitleState::prefetch()
+{
+  image_manager_.prefetch(episode_, CCImage::IMAGE_TITLE);
+  image_manager_.prefetch(episode_, CCImage::IMAGE_CREDITS);
+}
+
 void TitleState::draw(Window& window) const
 {
+  const auto& title_images = image_manager_.get_images(episode_, CCImage::IMAGE_TITLE);
+  const auto& credits_images = image_manager_.get_images(episode_, CCImage::IMAGE_CREDITS);
+  images_.assign(title_images.begin(), title_images.end());
+  images_.insert(images_.end(), credits_images.begin(), credits_images.end());
   constexpr unsigned first_ticks = 50;
   constexpr unsigned scroll_ticks = 50;
   constexpr unsigned last_ticks = 50;
   const auto period_ticks = first_ticks + scroll_ticks * 2 + last_ticks;
   const auto ticks = scroll_ticks_ % period_ticks;
-  if (ticks < first_ticks)
+  if (images_.empty())
+  {
+    // Nothing could be decoded, get_images() has logged it
+  }
+  else if (ticks < first_ticks)
   {
     // Show first image
     images_[0]->blit_surface(geometry::Rectangle(0, 0, images_[0]->size()),
@@ -438,6 +459,8 @@ void GameState::reset()
     }
   }
   paused_ = false;
+  // Fast forward doesn't carry over into a new level or game
+  time_scale_ = 1;
   panel_current_ = nullptr;
   panel_next_ = nullptr;
   if (!game_.init(sound_manager_, exe_data_, level_, player_state_, previous_level))
@@ -448,7 +471,11 @@ void GameState::reset()
   else
   {
     sound_manager_.play_sound(SoundType::SOUND_START_LEVEL);
+    // The last snapshot points at the previous level
+    game_renderer_.publish_snapshot();
   }
+  // Free palette variants the previous level did not use
+  sprite_manager_.release_unused_palettes();
   if (level_ == LevelId::INTRO)
   {
     // Show intro scrawl
@@ -460,12 +487,15 @@ void GameState::reset()
     // Show finale scrawl
     panel_current_ = &finale_panel_;
     intro_ticks_ = 0;
+    // The end screen is next
+    end_state_->prefetch();
   }
 }
 
 void GameState::update(const Input& input)
 {
   State::update(input);
+  game_updated_ = false;
   auto pi = input_to_player_input(input);
   // Intro-specific state updates
   if (level_ == LevelId::INTRO && panel_current_ == nullptr && fade_out_start_ticks_ == 0)
@@ -727,12 +757,17 @@ void GameState::update(const Input& input)
     {
       paused_ = !paused_;
     }
+    if (input.tab.pressed())
+    {
+      time_scale_ = time_scale_ == 0 ? 1 : (time_scale_ == 8 ? 0 : time_scale_ * 2);
+    }
 
     if (!paused_ || (paused_ && input.space.pressed()))
     {
       // Call game loop
       game_.update(game_tick_, pi);
       game_tick_ += 1;
+      game_updated_ = true;
 
       if (game_.get_player().health_ == 0 && game_.get_player().dying_tick == 0)
       {
@@ -771,12 +806,19 @@ void GameState::draw(Window& window) const
   window.fill_rect(geometry::Rectangle(0, 0, WINDOW_SIZE), {33u, 33u, 33u});
 
   // Render game
-  game_renderer_.render_game(game_tick_);
+  game_renderer_.render_game(game_updated_ ? tick_alpha_ : 1.0f);
+  capture_frame(window);
 
   // Render game surface to window surface, centered and scaled
   game_surface_.blit_surface(geometry::Rectangle(0, 0, CAMERA_SIZE),
                              geometry::Rectangle((WINDOW_SIZE - CAMERA_SIZE_SCALED) / 2, CAMERA_SIZE_SCALED));
 
+  if (time_scale_ != 1)
+  {
+    sprite_manager_.render_text(time_scale_ == 0 ? L"max" : std::to_wstring(time_scale_) + L"x",
+                                geometry::Position(WINDOW_SIZE.x() - 5 * CHAR_W, 5));
+  }
+
   // Debug information
   if (debug_info_)
   {
@@ -825,6 +867,28 @@ void GameState::draw(Window& window) const
   State::draw(window);
 }
 
+void GameState::capture_frame(Window& window) const
+{
+  if (!frame_capture_ || game_tick_ == last_captured_tick_)
+  {
+    return;
+  }
+  last_captured_tick_ = game_tick_;
+  // Only the read back happens here, encoding and writing is done by the capture thread
+  // If it has fallen behind the frame is dropped rather than waiting
+  auto* pixels = frame_capture_->acquire();
+  if (!pixels)
+  {
+    return;
+  }
+  window.set_render_target(&game_surface_);
+  if (window.read_pixels(*pixels))
+  {
+    frame_capture_->submit();
+  }
+  window.set_render_target(nullptr);
+}
+
 State* GameState::next_state()
 {
   if (has_finished())
@@ -847,17 +911,19 @@ State* GameState::next_state()
   return State::next_state();
 }
 
-EndState::EndState(SpriteManager& sprite_manager,
+EndState::EndState(const int episode,
+                   SpriteManager& sprite_manager,
                    SoundManager& sound_manager,
                    Surface& game_surface,
-                   std::vector<Surface*>& images,
+                   ImageManager& image_manager,
                    Window& window,
                    ExeData& exe_data)
   : State(FADE_IN_TICKS, 0, window),
     sprite_manager_(sprite_manager),
     sound_manager_(sound_manager),
     game_surface_(game_surface),
-    images_(images),
+    image_manager_(image_manager),
+    episode_(episode),
     outro_panel_(PanelText::PANEL_TEXT_END_1, exe_data),
     congrats_panel_(
       {
@@ -869,6 +935,21 @@ EndState::EndState(SpriteManager& sprite_manager,
   panel_current_ = &outro_panel_;
 }
 
+void EndState::reset()
+{
+  State::reset();
+  // The title screen is next
+  if (next_state_)
+  {
+    next_state_->prefetch();
+  }
+}
+
+void EndState::prefetch()
+{
+  image_manager_.prefetch(episode_, CCImage::IMAGE_END);
+}
+
 void EndState::update(const Input& input)
 {
   State::update(input);
@@ -906,8 +987,12 @@ void EndState::update(const Input& input)
 void EndState::draw(Window& window) const
 {
   // Just draw the image for now
-  images_[0]->blit_surface(geometry::Rectangle(0, 0, images_[0]->size()),
-                           geometry::Rectangle((WINDOW_SIZE - CAMERA_SIZE_SCALED) / 2, CAMERA_SIZE_SCALED));
+  const auto& images = image_manager_.get_images(episode_, CCImage::IMAGE_END);
+  if (!images.empty())
+  {
+    images[0]->blit_surface(geometry::Rectangle(0, 0, images[0]->size()),
+                            geometry::Rectangle((WINDOW_SIZE - CAMERA_SIZE_SCALED) / 2, CAMERA_SIZE_SCALED));
+  }
 
   if (panel_current_)
   {
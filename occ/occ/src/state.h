@@ -1,8 +1,10 @@
 #pragma once
 
 #include "event.h"
+#include "frame_capture.h"
 #include "game_renderer.h"
 #include "graphics.h"
+#include "imagemgr.h"
 #include "player_state.h"
 #include "sdl_wrapper.h"
 #include "soundmgr.h"
@@ -42,6 +44,14 @@ class State
   virtual State* next_state() { return has_finished() ? next_state_ : this; }
 
   virtual void draw(Window& window) const = 0;
+  // How far into the next tick the next draw() is, in [0, 1]
+  void set_tick_alpha(const float tick_alpha) { tick_alpha_ = tick_alpha; }
+
+  // Called when this state is likely to be entered soon, to start loading what it needs
+  virtual void prefetch() {}
+
+  // How many times faster than real time to run, 0 means as fast as possible
+  virtual unsigned get_time_scale() const { return 1; }
 
  protected:
   unsigned ticks_ = 0;
@@ -50,6 +60,7 @@ class State
   unsigned fade_in_ticks_;
   unsigned fade_out_ticks_;
   unsigned fade_out_start_ticks_ = 0;
+  float tick_alpha_ = 1.0f;
 };
 
 /// State that can be skipped with a button press
@@ -67,14 +78,15 @@ class SkipState : public virtual State
 class SplashState : public SkipState
 {
  public:
-  SplashState(SoundManager& sound_manager, std::vector<Surface*>& images, Window& window);
+  SplashState(const int episode, SoundManager& sound_manager, ImageManager& image_manager, Window& window);
 
   virtual void reset() override;
   virtual void draw(Window& window) const override;
 
  private:
   SoundManager& sound_manager_;
-  std::vector<Surface*>& images_;
+  ImageManager& image_manager_;
+  int episode_;
 };
 
 class TitleState : public State
@@ -84,7 +96,7 @@ class TitleState : public State
              SpriteManager& sprite_manager,
              SoundManager& sound_manager,
              Surface& game_surface,
-             std::vector<Surface*>& images,
+             ImageManager& image_manager,
              Window& window,
              ExeData& exe_data,
              PlayerState& player_state);
@@ -97,6 +109,7 @@ class TitleState : public State
   virtual void finish() override;
   virtual void update(const Input& input) override;
   virtual void draw(Window& window) const override;
+  virtual void prefetch() override;
   virtual State* next_state() override
   {
     if (panel_current_ && panel_current_->get_type() == PanelType::PANEL_TYPE_QUIT_TO_OS)
@@ -110,7 +123,10 @@ class TitleState : public State
   SpriteManager& sprite_manager_;
   SoundManager& sound_manager_;
   Surface& game_surface_;
-  std::vector<Surface*>& images_;
+  ImageManager& image_manager_;
+  int episode_;
+  // Title followed by credits images, refreshed each draw
+  mutable std::vector<Surface*> images_;
   PlayerState& player_state_;
   unsigned scroll_ticks_ = 0;
   Panel panel_;
@@ -134,7 +150,14 @@ class GameState : public State
   virtual void draw(Window& window) const override;
   virtual State* next_state() override;
 
+  // Captures the game surface once per game tick while set
+  void set_frame_capture(FrameCapture* frame_capture) { frame_capture_ = frame_capture; }
+
+  virtual unsigned get_time_scale() const override { return time_scale_; }
+
  private:
+  void capture_frame(Window& window) const;
+
   Game& game_;
   Surface& game_surface_;
   SpriteManager& sprite_manager_;
@@ -146,6 +169,10 @@ class GameState : public State
   bool debug_info_ = false;
   bool paused_ = false;
   unsigned game_tick_ = 0;
+  // Whether the game was updated in the last tick, only then is there motion to interpolate
+  bool game_updated_ = false;
+  // Cycled with tab: 1x, 2x, 4x, 8x, uncapped
+  unsigned time_scale_ = 1;
   LevelId level_ = LevelId::INTRO;
   Panel panel_;
   Panel warp_panel_;
@@ -159,26 +186,32 @@ class GameState : public State
   unsigned intro_ticks_ = 0;
   Panel* panel_current_ = nullptr;
   Panel* panel_next_ = nullptr;
+  FrameCapture* frame_capture_ = nullptr;
+  mutable unsigned last_captured_tick_ = 0;
 };
 
 class EndState : public State
 {
  public:
-  EndState(SpriteManager& sprite_manager,
+  EndState(const int episode,
+           SpriteManager& sprite_manager,
            SoundManager& sound_manager,
            Surface& game_surface,
-           std::vector<Surface*>& images,
+           ImageManager& image_manager,
            Window& window,
            ExeData& exe_data);
 
+  virtual void reset() override;
   virtual void update(const Input& input) override;
   virtual void draw(Window& window) const override;
+  virtual void prefetch() override;
 
  private:
   Surface& game_surface_;
   SpriteManager& sprite_manager_;
   SoundManager& sound_manager_;
-  std::vector<Surface*>& images_;
+  ImageManager& image_manager_;
+  int episode_;
   Panel outro_panel_;
   Panel congrats_panel_;
   Panel* panel_current_ = nullptr;
@@ -0,0 +1,54 @@
+#include "text_cache.h"
+
+#include "logger.h"
+
+namespace
+{
+// Surfaces are allocated in steps so they can be reused for text of a similar length
+constexpr int TEXT_SURFACE_STEP = 64;
+}  // namespace
+
+const Surface* TextCache::find(const std::wstring& key)
+{
+  const auto it = index_.find(key);
+  if (it == index_.end())
+  {
+    return nullptr;
+  }
+  entries_.splice(entries_.begin(), entries_, it->second);
+  return it->second->surface.get();
+}
+
+Surface* TextCache::insert(Window& window, const std::wstring& key, const geometry::Size& size)
+{
+  std::unique_ptr<Surface> surface;
+  if (capacity_ > 0 && entries_.size() >= capacity_)
+  {
+    auto& lru = entries_.back();
+    if (lru.surface->width() >= size.x() && lru.surface->height() >= size.y())
+    {
+      surface = std::move(lru.surface);
+    }
+    index_.erase(lru.key);
+    entries_.pop_back();
+  }
+  if (!surface)
+  {
+    const geometry::Size surface_size{(size.x() + TEXT_SURFACE_STEP - 1) / TEXT_SURFACE_STEP * TEXT_SURFACE_STEP, size.y()};
+    surface = window.create_target_surface(surface_size);
+    if (!surface)
+    {
+      LOG_ERROR("Could not create text surface");
+      return nullptr;
+    }
+  }
+  entries_.push_front({key, std::move(surface)});
+  index_[key] = entries_.begin();
+  return entries_.front().surface.get();
+}
+
+void TextCache::clear()
+{
+  index_.clear();
+  entries_.clear();
+}
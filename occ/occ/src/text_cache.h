@@ -0,0 +1,39 @@
+#pragma once
+
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "geometry.h"
+#include "graphics.h"
+
+constexpr size_t TEXT_CACHE_ENTRIES = 64;
+
+/// Small target surfaces holding pre-rendered lines of text, keyed by content
+/// When full, the least recently used entry is evicted and its surface is reused if it is large enough
+class TextCache
+{
+ public:
+  explicit TextCache(size_t capacity = TEXT_CACHE_ENTRIES) : capacity_(capacity) {}
+
+  // Returns nullptr if key is not cached
+  const Surface* find(const std::wstring& key);
+  // Adds an entry with a surface of at least size and returns the surface to render the text to,
+  // or nullptr if no surface could be created
+  Surface* insert(Window& window, const std::wstring& key, const geometry::Size& size);
+  void clear();
+  size_t size() const { return entries_.size(); }
+
+ private:
+  struct Entry
+  {
+    std::wstring key;
+    std::unique_ptr<Surface> surface;
+  };
+
+  size_t capacity_;
+  // Most recently used first
+  std::list<Entry> entries_;
+  std::unordered_map<std::wstring, std::list<Entry>::iterator> index_;
+};
@@ -1,8 +1,10 @@
 #pragma once
 
-#include <map>
+#include <array>
+#include <utility>
 
-const std::map<wchar_t, int> char_map{
+// Glyph index in the font for each supported character
+constexpr std::pair<wchar_t, int> char_list[]{
   {' ', 10},
   {'!', 11},
   {'"', 12},
@@ -91,3 +93,39 @@ const std::map<wchar_t, int> char_map{
   {'y', 93},
   {'z', 94},
 };
+
+constexpr int CHAR_TABLE_SIZE = 256;
+
+// Flat lookup table for the characters below CHAR_TABLE_SIZE, -1 where there is no glyph
+constexpr std::array<int, CHAR_TABLE_SIZE> make_char_table()
+{
+  std::array<int, CHAR_TABLE_SIZE> table{};
+  table.fill(-1);
+  for (const auto& [ch, idx] : char_list)
+  {
+    if (static_cast<unsigned>(ch) < CHAR_TABLE_SIZE)
+    {
+      table[ch] = idx;
+    }
+  }
+  return table;
+}
+
+constexpr auto char_table = make_char_table();
+
+// Glyph index for ch, or the glyph for space if there is none
+constexpr int get_char_index(const wchar_t ch)
+{
+  if (static_cast<unsigned>(ch) < CHAR_TABLE_SIZE)
+  {
+    return char_table[ch] != -1 ? char_table[ch] : char_table[L' '];
+  }
+  for (const auto& [c, idx] : char_list)
+  {
+    if (c == ch)
+    {
+      return idx;
+    }
+  }
+  return char_table[L' '];
+}
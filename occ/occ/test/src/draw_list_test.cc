@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "draw_list.h"
+#include "geometry.h"
+#include "graphics.h"
+
+namespace
+{
+
+// Adds a 16x16 sprite drawn at x, 0
+void add_sprite(DrawList& draw_list, DrawList::Layer layer, int sprite, int x, int palette = 0)
+{
+  draw_list.add_sprite(layer, sprite, {x, 0}, {0, 0}, {x, 0, 16, 16}, {0xff, 0xff, 0xff}, palette);
+}
+
+// Sprite of each command in submit order, -1 for surfaces
+std::vector<int> sorted_sprites(DrawList& draw_list)
+{
+  draw_list.sort();
+  std::vector<int> sprites;
+  for (size_t i = 0; i < draw_list.size(); i++)
+  {
+    sprites.push_back(draw_list[i].sprite);
+  }
+  return sprites;
+}
+
+}  // namespace
+
+TEST(DrawList, layers_in_order)
+{
+  DrawList draw_list;
+  add_sprite(draw_list, DrawList::Layer::FRONT_OBJECTS, 1, 0);
+  add_sprite(draw_list, DrawList::Layer::BACKGROUND, 2, 0);
+  add_sprite(draw_list, DrawList::Layer::PLAYER, 3, 0);
+  EXPECT_EQ((std::vector<int>{2, 3, 1}), sorted_sprites(draw_list));
+}
+
+TEST(DrawList, batches_palettes_that_do_not_overlap)
+{
+  DrawList draw_list;
+  add_sprite(draw_list, DrawList::Layer::ENEMIES, 1, 0, 1);
+  add_sprite(draw_list, DrawList::Layer::ENEMIES, 2, 32, 0);
+  add_sprite(draw_list, DrawList::Layer::ENEMIES, 3, 64, 1);
+  add_sprite(draw_list, DrawList::Layer::ENEMIES, 4, 96, 0);
+  EXPECT_EQ((std::vector<int>{2, 4, 1, 3}), sorted_sprites(draw_list));
+}
+
+TEST(DrawList, keeps_order_of_overlapping_commands)
+{
+  DrawList draw_list;
+  // Bright enemy behind a normal one
+  add_sprite(draw_list, DrawList::Layer::ENEMIES, 1, 0, 2);
+  add_sprite(draw_list, DrawList::Layer::ENEMIES, 2, 8, 0);
+  add_sprite(draw_list, DrawList::Layer::ENEMIES, 3, 8, 2);
+  EXPECT_EQ((std::vector<int>{1, 2, 3}), sorted_sprites(draw_list));
+
+  draw_list.clear();
+  add_sprite(draw_list, DrawList::Layer::ENEMIES, 1, 0, 2);
+  add_sprite(draw_list, DrawList::Layer::ENEMIES, 2, 16, 0);
+  EXPECT_EQ((std::vector<int>{2, 1}), sorted_sprites(draw_list));
+}
+
+TEST(DrawList, sprites_on_top_of_earlier_surfaces)
+{
+  auto window = Window::create_software({64, 16});
+  ASSERT_TRUE(window);
+  auto chunk_1 = window->create_target_surface({32, 16});
+  auto chunk_2 = window->create_target_surface({32, 16});
+  ASSERT_TRUE(chunk_1 && chunk_2);
+
+  // Static tile chunks first, then a sprite reaching from the first chunk into the second
+  DrawList draw_list;
+  draw_list.add_surface(DrawList::Layer::BACK_TILES, DrawList::TEXTURE_SURFACE + 0, *chunk_1, {0, 0, 32, 16}, {0, 0, 32, 16});
+  draw_list.add_surface(DrawList::Layer::BACK_TILES, DrawList::TEXTURE_SURFACE + 1, *chunk_2, {0, 0, 32, 16}, {32, 0, 32, 16});
+  draw_list.add_sprite(DrawList::Layer::BACK_TILES, 1, {40, 0}, {0, 0}, {24, 0, 32, 16}, {0xff, 0xff, 0xff}, 0);
+  draw_list.sort();
+  ASSERT_EQ(3u, draw_list.size());
+  EXPECT_EQ(chunk_1.get(), draw_list[0].surface);
+  EXPECT_EQ(chunk_2.get(), draw_list[1].surface);
+  EXPECT_EQ(1, draw_list[2].sprite);
+}
@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "constants.h"
+#include "game.h"
+#include "game_renderer.h"
+#include "geometry.h"
+#include "graphics.h"
+#include "level.h"
+#include "sprite.h"
+#include "spritemgr.h"
+#include "utils.h"
+
+namespace
+{
+
+constexpr int LEVEL_W = 100;
+constexpr int LEVEL_H = 30;
+
+// A level with a horizon, background walls, a floor, and animated and in front tiles, without the game data
+class TestGame : public Game
+{
+ public:
+  TestGame()
+  {
+    level.level_id = LevelId::LEVEL_1;
+    level.width = LEVEL_W;
+    level.height = LEVEL_H;
+    level.bgs = std::make_shared<ChunkedGrid<int>>(LEVEL_W, LEVEL_H, -1);
+    level.tiles = std::make_shared<ChunkedGrid<Tile>>(LEVEL_W, LEVEL_H, Tile::INVALID);
+    for (int y = 0; y < LEVEL_H; y++)
+    {
+      for (int x = 0; x < LEVEL_W; x++)
+      {
+        level.bgs->set(x, y, y < 2 ? static_cast<int>(Sprite::SPRITE_HORIZON_1) + x % 4 : 100 + (x * 3 + y) % 8);
+        if (y == LEVEL_H - 1)
+        {
+          level.tiles->set(x, y, Tile(40 + x % 2, 1, TILE_SOLID));
+        }
+        else if (y == LEVEL_H - 2 && x % 7 == 0)
+        {
+          level.tiles->set(x, y, Tile(60, 4, TILE_ANIMATED));
+        }
+        else if (y == LEVEL_H - 3 && x % 5 == 0)
+        {
+          level.tiles->set(x, y, Tile(80, 1, TILE_RENDER_IN_FRONT));
+        }
+      }
+    }
+    player.position = {SPRITE_W, (LEVEL_H - 2) * SPRITE_H};
+    player.prev_position = player.position;
+  }
+
+  bool init(AbstractSoundManager&, const ExeData&, const LevelId, const PlayerState&, const LevelId) override { return true; }
+  void update(unsigned, const PlayerInput&) override {}
+  const Player& get_player() const override { return player; }
+  const Level& get_level() const override { return level; }
+  int get_tile_width() const override { return level.width; }
+  int get_tile_height() const override { return level.height; }
+  const std::vector<Object>& get_objects() const override { return objects; }
+  unsigned get_score() const override { return 1234; }
+  unsigned get_num_ammo() const override { return 5; }
+  std::wstring get_debug_info() const override { return L""; }
+
+  Level level;
+  Player player;
+  std::vector<Object> objects;
+};
+
+class GameRendererTest : public ::testing::Test
+{
+ protected:
+  void SetUp() override
+  {
+    window_ = Window::create_software(CAMERA_SIZE);
+    ASSERT_TRUE(window_);
+    game_surface_ = window_->create_target_surface(CAMERA_SIZE);
+    ASSERT_TRUE(game_surface_);
+
+    // Every sprite gets its own pattern of the 16 palette colours
+    constexpr int sheet_w = 16 * SPRITE_W;
+    constexpr int sheet_h = 80 * SPRITE_H;
+    std::vector<uint8_t> indices(sheet_w * sheet_h);
+    for (int y = 0; y < sheet_h; y++)
+    {
+      for (int x = 0; x < sheet_w; x++)
+      {
+        const int sprite = (y / SPRITE_H) * 16 + x / SPRITE_W;
+        indices[y * sheet_w + x] = static_cast<uint8_t>((sprite * 5 + (x % SPRITE_W) / 4 + ((y % SPRITE_H) / 4) * 3) % 16);
+      }
+    }
+    sprite_manager_.remaster = false;
+    ASSERT_TRUE(sprite_manager_.load_tilesets(*window_, std::move(indices), sheet_w, sheet_h));
+    renderer_ = std::make_unique<GameRenderer>(&game_, &sprite_manager_, game_surface_.get(), *window_);
+  }
+
+  // Moves the player and lets the camera catch up, without interpolating from the old position
+  void move_player(const int x)
+  {
+    game_.player.position = {x, game_.player.position.y()};
+    game_.player.prev_position = game_.player.position;
+    renderer_->update(0);
+    renderer_->update(0);
+  }
+
+  // FNV-1a of the rendered game surface
+  uint64_t render_checksum()
+  {
+    renderer_->render_game();
+    window_->set_render_target(game_surface_.get());
+    std::vector<uint32_t> pixels;
+    EXPECT_TRUE(window_->read_pixels(pixels));
+    window_->set_render_target(nullptr);
+    EXPECT_EQ(static_cast<size_t>(CAMERA_SIZE.x() * CAMERA_SIZE.y()), pixels.size());
+    uint64_t hash = 14695981039346656037ull;
+    for (const auto pixel : pixels)
+    {
+      hash = (hash ^ pixel) * 1099511628211ull;
+    }
+    return hash;
+  }
+
+  TestGame game_;
+  SpriteManager sprite_manager_;
+  std::unique_ptr<Window> window_;
+  std::unique_ptr<Surface> game_surface_;
+  std::unique_ptr<GameRenderer> renderer_;
+};
+
+}  // namespace
+
+// Update the checksum only after checking that a change to the rendered frame is intended
+TEST_F(GameRendererTest, golden_frame)
+{
+  EXPECT_EQ(0x7ffeaecac36d4f95ull, render_checksum());
+}
+
+TEST_F(GameRendererTest, same_frame_after_chunks_are_freed)
+{
+  const auto start = render_checksum();
+
+  // Far enough that the chunks seen at the start are freed, and back again to where the camera is clamped to the level edge
+  move_player((LEVEL_W - 10) * SPRITE_W);
+  EXPECT_NE(start, render_checksum());
+  move_player(SPRITE_W);
+  EXPECT_EQ(start, render_checksum());
+}
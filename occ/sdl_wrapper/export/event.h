@@ -56,6 +56,7 @@ struct Input
   Button space = Button();
   Button escape = Button();
   Button backspace = Button();
+  Button tab = Button();
 
   // Cheat code buttons
   Button noclip = Button();
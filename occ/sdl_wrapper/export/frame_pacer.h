@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+
+#include "sdl_wrapper.h"
+
+/// Fixed rate tick clock for the game loop, based on the performance counter
+/// Elapsed time is accumulated exactly in units of 1 / (frequency * ticks_num) seconds, so ticks don't drift
+/// even when the tick length isn't a whole number of milliseconds or counter units
+class FramePacer
+{
+ public:
+  // Runs ticks_num / ticks_den ticks per second
+  // After a stall at most max_ticks_per_frame ticks are run at once and the rest of the backlog is dropped
+  FramePacer(SDLWrapper& sdl, const unsigned ticks_num, const unsigned ticks_den, const unsigned max_ticks_per_frame = 5);
+
+  // Sleeps and then spins until the next tick is due
+  void wait_for_tick();
+  // Returns the number of ticks that are due
+  unsigned advance();
+  // Runs scale times as many ticks per second, 0 means as fast as possible
+  // After a stall at most max_ticks_per_frame * scale ticks are run at once
+  // Time elapsed before the change still counts at the old scale
+  void set_time_scale(const unsigned scale);
+  unsigned get_time_scale() const { return time_scale_; }
+
+  // Fraction of the next tick that had elapsed at the last advance(), in [0, 1)
+  float get_alpha() const { return static_cast<float>(accumulator_) / static_cast<float>(tick_length_); }
+
+  // Call once per presented frame
+  void count_frame();
+  // Presented frames per second, updated every second
+  float get_fps() const { return fps_; }
+  // True if frames are presented far more often than the display refreshes, i.e. vsync isn't waiting
+  // A refresh rate of 0 (unknown) is treated as the fastest common display
+  bool outpaces_display(const int refresh_rate) const;
+
+ private:
+  void update();
+
+  SDLWrapper& sdl_;
+  uint64_t ticks_num_;
+  uint64_t frequency_;
+  // One tick in accumulator units
+  uint64_t tick_length_;
+  unsigned max_ticks_per_frame_;
+  unsigned time_scale_ = 1;
+  uint64_t last_counter_;
+  uint64_t accumulator_ = 0;
+
+  uint64_t fps_start_;
+  unsigned fps_frames_ = 0;
+  float fps_ = 0.0f;
+};
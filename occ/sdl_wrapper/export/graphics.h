@@ -1,11 +1,14 @@
 #pragma once
 
+#include <cstdint>
 #include <filesystem>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "geometry.h"
 
+class Image;
 class Surface;
 
 struct Color
@@ -14,6 +17,19 @@ struct Color
   std::uint8_t green = 0u;
   std::uint8_t blue = 0u;
   std::uint8_t alpha = 0xffu;
+
+  bool operator==(const Color& other) const = default;
+};
+
+/// Renderer calls and state changes made during one frame
+struct RenderStats
+{
+  unsigned draw_calls = 0u;
+  unsigned batched_quads = 0u;
+  unsigned draw_color_changes = 0u;
+  unsigned color_mod_changes = 0u;
+  unsigned blend_mode_changes = 0u;
+  unsigned render_target_changes = 0u;
 };
 
 class Window
@@ -23,16 +39,40 @@ class Window
                                         geometry::Size size,
                                         const std::filesystem::path& icon_path,
                                         const int flags = 0);
+  // Renders into CPU memory without the SDL video subsystem, e.g. for headless runs and golden frame tests
+  static std::unique_ptr<Window> create_software(geometry::Size size);
 
   virtual ~Window() = default;
 
   virtual void set_size(geometry::Size size) = 0;
+  // Makes refresh() wait for the display's vertical blank, returns false if not supported
+  virtual bool set_vsync(const bool vsync) = 0;
+  // Refresh rate of the display the window is on in Hz, 0 if unknown
+  virtual int get_refresh_rate() const = 0;
   virtual void set_render_target(Surface* surface) = 0;
+  // nullptr if rendering to the window
+  virtual Surface* get_render_target() const = 0;
   virtual std::unique_ptr<Surface> create_target_surface(geometry::Size size) = 0;
+  virtual std::unique_ptr<Surface> create_surface(const Image& image) = 0;
   virtual void refresh() = 0;
   virtual void fill_rect(const geometry::Rectangle& rect, const Color& color) = 0;
   virtual void render_line(const geometry::Position& from, const geometry::Position& to, const Color& color) = 0;
   virtual void render_rectangle(const geometry::Rectangle& rect, const Color& color) = 0;
+
+  // Queues a blit; consecutive blits from the same surface are drawn together on flush
+  // or when anything else is drawn
+  virtual void blit_batched(const Surface& surface,
+                            const geometry::Rectangle& source,
+                            const geometry::Rectangle& dest,
+                            const bool flip = false,
+                            const Color color = {0xff, 0xff, 0xff}) = 0;
+  virtual void flush() = 0;
+
+  // Stats of the last frame, updated on refresh
+  virtual const RenderStats& get_render_stats() const = 0;
+
+  // Reads the current render target as ARGB8888, row by row, drawing any queued blits first
+  virtual bool read_pixels(std::vector<uint32_t>& pixels) = 0;
 };
 
 enum class BlitType
@@ -41,9 +81,25 @@ enum class BlitType
   SCALE
 };
 
+/// Decoded image in CPU memory
+/// Unlike Surface this doesn't need the Window, so it can be created on any thread and turned into a Surface later
+class Image
+{
+ public:
+  static std::unique_ptr<Image> from_image(const std::filesystem::path& filename);
+  static std::unique_ptr<Image> from_pcx_image(const std::filesystem::path& filename);
+  static std::unique_ptr<Image> from_pixels(const int w, const int h, const uint32_t* pixels);
+
+  virtual ~Image() = default;
+
+  virtual int width() const = 0;
+  virtual int height() const = 0;
+};
+
 class Surface
 {
  public:
+  static std::unique_ptr<Surface> from_image_data(const Image& image, Window& window);
   static std::unique_ptr<Surface> from_bmp(const std::filesystem::path& filename, Window& window);
   static std::unique_ptr<Surface> from_image(const std::filesystem::path& filename, Window& window);
   static std::unique_ptr<Surface> from_pcx_image(const std::filesystem::path& filename, Window& window);
@@ -1,6 +1,7 @@
 #ifndef SDL_WRAPPER_H_
 #define SDL_WRAPPER_H_
 
+#include <cstdint>
 #include <memory>
 
 class SDLWrapper
@@ -10,8 +11,12 @@ class SDLWrapper
 
   virtual ~SDLWrapper() = default;
 
-  virtual bool init() = 0;
+  // headless skips the video subsystem, see Window::create_software
+  virtual bool init(const bool headless = false) = 0;
   virtual unsigned get_tick() = 0;
+  // High resolution clock, get_performance_frequency() counts per second
+  virtual uint64_t get_performance_counter() = 0;
+  virtual uint64_t get_performance_frequency() = 0;
 	virtual void delay(const int ms) = 0;
 };
 
@@ -34,6 +34,7 @@ void EventImpl::poll_event(Input* input)
   input->space.tick();
   input->escape.tick();
   input->backspace.tick();
+  input->tab.tick();
   input->noclip.tick();
   input->ammo.tick();
   input->godmode.tick();
@@ -143,6 +144,10 @@ void EventImpl::poll_event(Input* input)
             input->backspace.set_down(event.type == SDL_KEYDOWN);
             break;
 
+          case SDLK_TAB:
+            input->tab.set_down(event.type == SDL_KEYDOWN);
+            break;
+
           default:
             break;
         }
@@ -0,0 +1,98 @@
+#include "frame_pacer.h"
+
+#include <algorithm>
+
+namespace
+{
+
+// SDL_Delay can oversleep by a millisecond or two, the last part of the wait is spent spinning
+constexpr uint64_t SPIN_MS = 2;
+
+// Ticks per frame when the time scale is uncapped, the frame rate is then only limited by vsync
+constexpr unsigned UNCAPPED_TICKS_PER_FRAME = 32;
+
+// Assumed when the display doesn't report its refresh rate
+constexpr int MAX_REFRESH_RATE = 360;
+
+// Missed or doubled vblanks don't get anywhere near this
+constexpr float VSYNC_SLACK = 2.0f;
+
+}  // namespace
+
+FramePacer::FramePacer(SDLWrapper& sdl, const unsigned ticks_num, const unsigned ticks_den, const unsigned max_ticks_per_frame)
+  : sdl_(sdl),
+    ticks_num_(ticks_num),
+    frequency_(sdl.get_performance_frequency()),
+    tick_length_(frequency_ * ticks_den),
+    max_ticks_per_frame_(max_ticks_per_frame),
+    last_counter_(sdl.get_performance_counter()),
+    fps_start_(last_counter_)
+{
+}
+
+void FramePacer::update()
+{
+  const auto counter = sdl_.get_performance_counter();
+  accumulator_ += (counter - last_counter_) * ticks_num_ * time_scale_;
+  last_counter_ = counter;
+}
+
+void FramePacer::wait_for_tick()
+{
+  if (time_scale_ == 0)
+  {
+    return;
+  }
+  update();
+  while (accumulator_ < tick_length_)
+  {
+    const auto remaining_ms = (tick_length_ - accumulator_) * 1000 / (ticks_num_ * time_scale_ * frequency_);
+    if (remaining_ms > SPIN_MS)
+    {
+      sdl_.delay(static_cast<int>(remaining_ms - SPIN_MS));
+    }
+    update();
+  }
+}
+
+void FramePacer::set_time_scale(const unsigned scale)
+{
+  if (scale == time_scale_)
+  {
+    return;
+  }
+  update();
+  time_scale_ = scale;
+}
+
+unsigned FramePacer::advance()
+{
+  update();
+  if (time_scale_ == 0)
+  {
+    accumulator_ = 0;
+    return UNCAPPED_TICKS_PER_FRAME;
+  }
+  const auto ticks = accumulator_ / tick_length_;
+  accumulator_ -= ticks * tick_length_;
+  // Running the whole backlog after a stall would only make the next frame late as well
+  // At higher time scales frames are skipped by running more ticks per frame
+  return static_cast<unsigned>(std::min<uint64_t>(ticks, max_ticks_per_frame_ * time_scale_));
+}
+
+bool FramePacer::outpaces_display(const int refresh_rate) const
+{
+  return fps_ > VSYNC_SLACK * static_cast<float>(refresh_rate > 0 ? refresh_rate : MAX_REFRESH_RATE);
+}
+
+void FramePacer::count_frame()
+{
+  fps_frames_++;
+  const auto elapsed = sdl_.get_performance_counter() - fps_start_;
+  if (elapsed >= frequency_)
+  {
+    fps_ = static_cast<float>(fps_frames_) * static_cast<float>(frequency_) / static_cast<float>(elapsed);
+    fps_frames_ = 0;
+    fps_start_ += elapsed;
+  }
+}
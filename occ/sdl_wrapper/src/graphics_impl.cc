@@ -127,7 +127,7 @@ std::unique_ptr<Window> Window::create(const std::string& title,
   {
     return nullptr;
   }
-  auto window = std::make_unique<WindowImpl>(std::move(sdl_window), std::move(sdl_renderer));
+  auto window = std::make_unique<WindowImpl>(std::move(sdl_window), std::move(sdl_renderer), size);
   return window;
 }
 
@@ -135,6 +135,31 @@ void WindowImpl::set_size(geometry::Size size)
 {
   // TODO: check error
   SDL_SetWindowSize(sdl_window_.get(), size.x(), size.y());
+  size_ = size;
+}
+
+bool WindowImpl::set_vsync(const bool vsync)
+{
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+  if (SDL_RenderSetVSync(sdl_renderer_.get(), vsync ? 1 : 0) == 0)
+  {
+    return true;
+  }
+  LOG_ERROR("Could not set vsync: %s", SDL_GetError());
+  return false;
+#else
+  return !vsync;
+#endif
+}
+
+int WindowImpl::get_refresh_rate() const
+{
+  SDL_DisplayMode mode;
+  if (SDL_GetWindowDisplayMode(sdl_window_.get(), &mode) != 0)
+  {
+    return 0;
+  }
+  return mode.refresh_rate;
 }
 
 void WindowImpl::set_render_target(Surface* surface)
@@ -145,7 +170,7 @@ void WindowImpl::set_render_target(Surface* surface)
   }
   else
   {
-    SDL_SetRenderTarget(sdl_renderer_.get(), nullptr);
+    render_context_.set_render_target(nullptr, nullptr);
   }
 }
 
@@ -158,20 +183,23 @@ std::unique_ptr<Surface> WindowImpl::create_target_surface(geometry::Size size)
     LOG_CRITICAL("Could not get texture: %s", SDL_GetError());
     return std::unique_ptr<Surface>();
   }
-  return std::make_unique<SurfaceImpl>(size.x(), size.y(), std::move(sdl_texture), *sdl_renderer_.get());
+  return std::make_unique<SurfaceImpl>(size.x(), size.y(), std::move(sdl_texture), render_context_);
 }
 
 void WindowImpl::refresh()
 {
+  render_context_.end_frame();
   SDL_RenderPresent(sdl_renderer_.get());
 }
 
 void WindowImpl::fill_rect(const geometry::Rectangle& rect, const Color& color)
 {
+  render_context_.flush();
   const auto sdl_rect = to_sdl_rect(rect);
+  render_context_.set_draw_color(color);
   // TODO: check error
-  SDL_SetRenderDrawColor(sdl_renderer_.get(), color.red, color.green, color.blue, color.alpha);
   SDL_RenderFillRect(sdl_renderer_.get(), &sdl_rect);
+  render_context_.count_draw_call();
 }
 
 void WindowImpl::render_rectangle(const geometry::Rectangle& rect, const Color& color)
@@ -200,28 +228,117 @@ SDL_Color to_sdl_color(const Color& color)
 
 void WindowImpl::render_line(const geometry::Position& from, const geometry::Position& to, const Color& color)
 {
+  render_context_.flush();
+  render_context_.set_draw_color({color.red, color.green, color.blue, 0xff});
   // TODO: check error
-  SDL_SetRenderDrawColor(sdl_renderer_.get(), color.red, color.green, color.blue, 0xff);
   SDL_RenderDrawLine(sdl_renderer_.get(), from.x(), from.y(), to.x(), to.y());
+  render_context_.count_draw_call();
 }
 
-std::unique_ptr<Surface> create_surface(SDL_Surface* surface, Window& window)
+void WindowImpl::blit_batched(const Surface& surface,
+                              const geometry::Rectangle& source,
+                              const geometry::Rectangle& dest,
+                              const bool flip,
+                              const Color color)
 {
-  auto sdl_surface = std::unique_ptr<SDL_Surface, decltype(&SDL_FreeSurface)>(surface, SDL_FreeSurface);
-  if (!sdl_surface)
+  static_cast<const SurfaceImpl&>(surface).blit_batched(source, dest, flip, color);
+}
+
+void WindowImpl::flush()
+{
+  render_context_.flush();
+}
+
+Surface* WindowImpl::get_render_target() const
+{
+  return render_context_.get_render_target();
+}
+
+const RenderStats& WindowImpl::get_render_stats() const
+{
+  return render_context_.get_last_frame_stats();
+}
+
+bool WindowImpl::read_pixels(std::vector<uint32_t>& pixels)
+{
+  render_context_.flush();
+  const auto* target = render_context_.get_render_target();
+  const auto size = target ? target->size() : size_;
+  pixels.resize(size.x() * size.y());
+  if (SDL_RenderReadPixels(sdl_renderer_.get(), nullptr, SDL_PIXELFORMAT_ARGB8888, pixels.data(), size.x() * sizeof(uint32_t)) != 0)
   {
-    LOG_CRITICAL("Could not load surface: %s", SDL_GetError());
-    return std::unique_ptr<Surface>();
+    LOG_ERROR("Could not read pixels: %s", SDL_GetError());
+    return false;
   }
-  auto sdl_renderer = static_cast<WindowImpl&>(window).get_renderer();
+  return true;
+}
+
+std::unique_ptr<Surface> WindowImpl::create_surface(const Image& image)
+{
+  auto& sdl_surface = *static_cast<const ImageImpl&>(image).get_surface();
   auto sdl_texture = std::unique_ptr<SDL_Texture, decltype(&SDL_DestroyTexture)>(
-    SDL_CreateTextureFromSurface(sdl_renderer, sdl_surface.get()), SDL_DestroyTexture);
+    SDL_CreateTextureFromSurface(sdl_renderer_.get(), &sdl_surface), SDL_DestroyTexture);
   if (!sdl_texture)
   {
     LOG_CRITICAL("Could not get texture: %s", SDL_GetError());
     return std::unique_ptr<Surface>();
   }
-  return std::make_unique<SurfaceImpl>(sdl_surface->w, sdl_surface->h, std::move(sdl_texture), *sdl_renderer);
+  return std::make_unique<SurfaceImpl>(sdl_surface.w, sdl_surface.h, std::move(sdl_texture), render_context_);
+}
+
+std::unique_ptr<Image> create_image(SDL_Surface* surface)
+{
+  auto sdl_surface = std::unique_ptr<SDL_Surface, decltype(&SDL_FreeSurface)>(surface, SDL_FreeSurface);
+  if (!sdl_surface)
+  {
+    LOG_CRITICAL("Could not load image: %s", SDL_GetError());
+    return std::unique_ptr<Image>();
+  }
+  return std::make_unique<ImageImpl>(std::move(sdl_surface));
+}
+
+SDL_Surface* pixels_to_surface(const int w, const int h, const uint32_t* pixels)
+{
+  auto sdl_surface = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_ARGB8888);
+  if (sdl_surface && pixels)
+  {
+    // TODO: check error
+    SDL_LockSurface(sdl_surface);
+    memcpy(sdl_surface->pixels, pixels, w * h * sizeof(*pixels));
+    SDL_UnlockSurface(sdl_surface);
+  }
+  return sdl_surface;
+}
+
+std::unique_ptr<Image> Image::from_image(const std::filesystem::path& filename)
+{
+  return create_image(load_image_to_surface(filename));
+}
+
+std::unique_ptr<Image> Image::from_pcx_image(const std::filesystem::path& filename)
+{
+  return create_image(load_pcx_image_to_surface(filename));
+}
+
+std::unique_ptr<Image> Image::from_pixels(const int w, const int h, const uint32_t* pixels)
+{
+  return create_image(pixels_to_surface(w, h, pixels));
+}
+
+// The image is decoded to CPU memory first so that each Window implementation only needs to handle Image
+std::unique_ptr<Surface> create_surface(SDL_Surface* surface, Window& window)
+{
+  const auto image = create_image(surface);
+  if (!image)
+  {
+    return std::unique_ptr<Surface>();
+  }
+  return window.create_surface(*image);
+}
+
+std::unique_ptr<Surface> Surface::from_image_data(const Image& image, Window& window)
+{
+  return window.create_surface(image);
 }
 
 std::unique_ptr<Surface> Surface::from_bmp(const std::filesystem::path& filename, Window& window)
@@ -231,76 +348,81 @@ std::unique_ptr<Surface> Surface::from_bmp(const std::filesystem::path& filename
 
 std::unique_ptr<Surface> Surface::from_image(const std::filesystem::path& filename, Window& window)
 {
-  auto sdl_surface = load_image_to_surface(filename);
-  return create_surface(sdl_surface, window);
+  return create_surface(load_image_to_surface(filename), window);
 }
 
 std::unique_ptr<Surface> Surface::from_pcx_image(const std::filesystem::path& filename, Window& window)
 {
-  auto sdl_surface = load_pcx_image_to_surface(filename);
-  return create_surface(sdl_surface, window);
+  return create_surface(load_pcx_image_to_surface(filename), window);
 }
 
 std::unique_ptr<Surface> Surface::from_pixels(const int w, const int h, const uint32_t* pixels, Window& window)
 {
-  auto sdl_surface = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_ARGB8888);
-  if (pixels)
-  {
-    // TODO: check error
-    SDL_LockSurface(sdl_surface);
-    memcpy(sdl_surface->pixels, pixels, w * h * sizeof(*pixels));
-    SDL_UnlockSurface(sdl_surface);
-  }
-  return create_surface(sdl_surface, window);
+  return create_surface(pixels_to_surface(w, h, pixels), window);
 }
 
 SurfaceImpl::SurfaceImpl(const int w,
                          const int h,
                          std::unique_ptr<SDL_Texture, decltype(&SDL_DestroyTexture)> sdl_texture,
-                         SDL_Renderer& sdl_renderer)
+                         RenderContext& render_context)
   : w_(w),
     h_(h),
     sdl_texture_(std::move(sdl_texture)),
-    sdl_renderer_(sdl_renderer)
+    render_context_(render_context),
+    sdl_renderer_(render_context.get_renderer())
 {
-  if (SDL_SetTextureBlendMode(sdl_texture_.get(), SDL_BLENDMODE_BLEND) != 0)
-  {
-    LOG_ERROR("Could not set texture blend mode: %s", SDL_GetError());
-  }
+  render_context_.set_blend_mode(sdl_texture_.get(), SDL_BLENDMODE_BLEND);
+}
+
+SurfaceImpl::~SurfaceImpl()
+{
+  render_context_.release_texture(sdl_texture_.get());
 }
 
 void SurfaceImpl::blit_surface(const geometry::Rectangle& source, const geometry::Rectangle& dest, const bool flip, const Color tint) const
 {
-  if (SDL_SetTextureColorMod(sdl_texture_.get(), tint.red, tint.green, tint.blue) != 0)
-  {
-    LOG_ERROR("Could not set texture color mod: %s", SDL_GetError());
-  }
+  render_context_.flush();
+  render_context_.set_color_mod(sdl_texture_.get(), color_mod_, tint);
   const auto src_rect = to_sdl_rect(source);
-  auto dest_rect = to_sdl_rect(dest);
-  const SDL_RendererFlip sdl_flip = flip ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
-  if (SDL_RenderCopyEx(&sdl_renderer_, sdl_texture_.get(), &src_rect, &dest_rect, 0.0, nullptr, sdl_flip) != 0)
+  const auto dest_rect = to_sdl_rect(dest);
+  // SDL_RenderCopyEx goes through the slower rotation path even without rotation
+  const int result = flip ? SDL_RenderCopyEx(&sdl_renderer_, sdl_texture_.get(), &src_rect, &dest_rect, 0.0, nullptr, SDL_FLIP_HORIZONTAL)
+                          : SDL_RenderCopy(&sdl_renderer_, sdl_texture_.get(), &src_rect, &dest_rect);
+  if (result != 0)
   {
     LOG_ERROR("Could not render texture: %s", SDL_GetError());
   }
-  // reset tint
-  if (SDL_SetTextureColorMod(sdl_texture_.get(), 0xff, 0xff, 0xff) != 0)
-  {
-    LOG_ERROR("Could not reset texture color mod: %s", SDL_GetError());
-  }
+  render_context_.count_draw_call();
 }
 
 void SurfaceImpl::blit_surface() const
 {
+  render_context_.flush();
+  render_context_.set_color_mod(sdl_texture_.get(), color_mod_, {0xff, 0xff, 0xff});
   // TODO: check error
   SDL_RenderCopy(&sdl_renderer_, sdl_texture_.get(), nullptr, nullptr);
+  render_context_.count_draw_call();
+}
+
+void SurfaceImpl::blit_batched(const geometry::Rectangle& source, const geometry::Rectangle& dest, const bool flip, const Color tint) const
+{
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+  // Vertex colors replace the texture color and alpha mod
+  render_context_.set_color_mod(sdl_texture_.get(), color_mod_, {0xff, 0xff, 0xff});
+  render_context_.add_quad(sdl_texture_.get(), size(), source, dest, flip, {tint.red, tint.green, tint.blue, alpha_});
+#else
+  blit_surface(source, dest, flip, tint);
+#endif
 }
 
 void SurfaceImpl::set_render_target()
 {
-  SDL_SetRenderTarget(&sdl_renderer_, sdl_texture_.get());
+  render_context_.set_render_target(this, sdl_texture_.get());
 }
 
 void SurfaceImpl::set_alpha(const uint8_t alpha)
 {
+  render_context_.flush();
+  alpha_ = alpha;
   SDL_SetTextureAlphaMod(sdl_texture_.get(), alpha);
 }
@@ -4,34 +4,68 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include <SDL.h>
 
 #include "geometry.h"
+#include "render_context.h"
 
 class WindowImpl : public Window
 {
  public:
   WindowImpl(std::unique_ptr<SDL_Window, decltype(&SDL_DestroyWindow)> sdl_window,
-             std::unique_ptr<SDL_Renderer, decltype(&SDL_DestroyRenderer)> sdl_renderer)
-    : sdl_window_(std::move(sdl_window)),
-      sdl_renderer_(std::move(sdl_renderer))
+             std::unique_ptr<SDL_Renderer, decltype(&SDL_DestroyRenderer)> sdl_renderer,
+             geometry::Size size)
+    : size_(size),
+      sdl_window_(std::move(sdl_window)),
+      sdl_renderer_(std::move(sdl_renderer)),
+      render_context_(*sdl_renderer_)
   {
   }
 
   void set_size(geometry::Size size) override;
+  bool set_vsync(const bool vsync) override;
+  int get_refresh_rate() const override;
   void set_render_target(Surface* surface) override;
+  Surface* get_render_target() const override;
   std::unique_ptr<Surface> create_target_surface(geometry::Size size) override;
+  std::unique_ptr<Surface> create_surface(const Image& image) override;
   void refresh() override;
   void fill_rect(const geometry::Rectangle& rect, const Color& color) override;
   void render_line(const geometry::Position& from, const geometry::Position& to, const Color& color) override;
   void render_rectangle(const geometry::Rectangle& rect, const Color& color) override;
+  void blit_batched(const Surface& surface,
+                    const geometry::Rectangle& source,
+                    const geometry::Rectangle& dest,
+                    const bool flip = false,
+                    const Color color = {0xff, 0xff, 0xff}) override;
+  void flush() override;
+  const RenderStats& get_render_stats() const override;
+  bool read_pixels(std::vector<uint32_t>& pixels) override;
 
   SDL_Renderer* get_renderer() const { return sdl_renderer_.get(); }
+  RenderContext& get_render_context() { return render_context_; }
 
  private:
+  geometry::Size size_;
   std::unique_ptr<SDL_Window, decltype(&SDL_DestroyWindow)> sdl_window_;
   std::unique_ptr<SDL_Renderer, decltype(&SDL_DestroyRenderer)> sdl_renderer_;
+  RenderContext render_context_;
+};
+
+class ImageImpl : public Image
+{
+ public:
+  explicit ImageImpl(std::unique_ptr<SDL_Surface, decltype(&SDL_FreeSurface)> sdl_surface) : sdl_surface_(std::move(sdl_surface)) {}
+
+  int width() const override { return sdl_surface_->w; }
+  int height() const override { return sdl_surface_->h; }
+
+  SDL_Surface* get_surface() const { return sdl_surface_.get(); }
+
+ private:
+  std::unique_ptr<SDL_Surface, decltype(&SDL_FreeSurface)> sdl_surface_;
 };
 
 class SurfaceImpl : public Surface
@@ -40,7 +74,8 @@ class SurfaceImpl : public Surface
   SurfaceImpl(const int w,
               const int h,
               std::unique_ptr<SDL_Texture, decltype(&SDL_DestroyTexture)> sdl_texture,
-              SDL_Renderer& sdl_renderer);
+              RenderContext& render_context);
+  ~SurfaceImpl() override;
 
   int width() const override { return w_; }
   int height() const override { return h_; }
@@ -50,6 +85,7 @@ class SurfaceImpl : public Surface
                     const bool flip = false,
                     const Color color = {0xff, 0xff, 0xff}) const override;
   void blit_surface() const override;
+  void blit_batched(const geometry::Rectangle& source, const geometry::Rectangle& dest, const bool flip, const Color color) const;
   void set_render_target();
   void set_alpha(const uint8_t alpha) override;
 
@@ -57,5 +93,8 @@ class SurfaceImpl : public Surface
   int w_;
   int h_;
   std::unique_ptr<SDL_Texture, decltype(&SDL_DestroyTexture)> sdl_texture_;
+  RenderContext& render_context_;
   SDL_Renderer& sdl_renderer_;
+  uint8_t alpha_ = 0xff;
+  mutable Color color_mod_ = {0xff, 0xff, 0xff};
 };
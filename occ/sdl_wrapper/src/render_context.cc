@@ -0,0 +1,156 @@
+#include "render_context.h"
+
+#include <utility>
+
+#include "logger.h"
+
+void RenderContext::set_render_target(Surface* surface, SDL_Texture* texture)
+{
+  flush();
+  render_target_surface_ = surface;
+  if (texture == render_target_)
+  {
+    return;
+  }
+  if (SDL_SetRenderTarget(&sdl_renderer_, texture) != 0)
+  {
+    LOG_ERROR("Could not set render target: %s", SDL_GetError());
+  }
+  render_target_ = texture;
+  stats_.render_target_changes++;
+}
+
+void RenderContext::set_draw_color(const Color& color)
+{
+  if (draw_color_valid_ && color == draw_color_)
+  {
+    return;
+  }
+  if (SDL_SetRenderDrawColor(&sdl_renderer_, color.red, color.green, color.blue, color.alpha) != 0)
+  {
+    LOG_ERROR("Could not set draw color: %s", SDL_GetError());
+  }
+  draw_color_ = color;
+  draw_color_valid_ = true;
+  stats_.draw_color_changes++;
+}
+
+void RenderContext::set_color_mod(SDL_Texture* texture, Color& current, const Color& color)
+{
+  if (color.red == current.red && color.green == current.green && color.blue == current.blue)
+  {
+    return;
+  }
+  if (SDL_SetTextureColorMod(texture, color.red, color.green, color.blue) != 0)
+  {
+    LOG_ERROR("Could not set texture color mod: %s", SDL_GetError());
+  }
+  current = color;
+  stats_.color_mod_changes++;
+}
+
+void RenderContext::set_blend_mode(SDL_Texture* texture, SDL_BlendMode blend_mode)
+{
+  if (SDL_SetTextureBlendMode(texture, blend_mode) != 0)
+  {
+    LOG_ERROR("Could not set texture blend mode: %s", SDL_GetError());
+  }
+  stats_.blend_mode_changes++;
+}
+
+void RenderContext::release_texture(SDL_Texture* texture)
+{
+  if (texture == texture_)
+  {
+    flush();
+    texture_ = nullptr;
+  }
+  // SDL resets the render target when the target texture is destroyed
+  if (texture == render_target_)
+  {
+    flush();
+    render_target_ = nullptr;
+    render_target_surface_ = nullptr;
+  }
+}
+
+void RenderContext::end_frame()
+{
+  flush();
+  last_frame_stats_ = stats_;
+  stats_ = RenderStats();
+}
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+
+void RenderContext::add_quad(SDL_Texture* texture,
+                             const geometry::Size& texture_size,
+                             const geometry::Rectangle& source,
+                             const geometry::Rectangle& dest,
+                             const bool flip,
+                             const Color color)
+{
+  if (texture != texture_)
+  {
+    flush();
+    texture_ = texture;
+  }
+
+  const float tw = static_cast<float>(texture_size.x());
+  const float th = static_cast<float>(texture_size.y());
+  float u0 = source.position.x() / tw;
+  float u1 = (source.position.x() + source.size.x()) / tw;
+  const float v0 = source.position.y() / th;
+  const float v1 = (source.position.y() + source.size.y()) / th;
+  if (flip)
+  {
+    std::swap(u0, u1);
+  }
+  const float x0 = static_cast<float>(dest.position.x());
+  const float x1 = static_cast<float>(dest.position.x() + dest.size.x());
+  const float y0 = static_cast<float>(dest.position.y());
+  const float y1 = static_cast<float>(dest.position.y() + dest.size.y());
+  const SDL_Color sdl_color = {color.red, color.green, color.blue, color.alpha};
+
+  const int first = static_cast<int>(vertices_.size());
+  vertices_.push_back({{x0, y0}, sdl_color, {u0, v0}});
+  vertices_.push_back({{x1, y0}, sdl_color, {u1, v0}});
+  vertices_.push_back({{x1, y1}, sdl_color, {u1, v1}});
+  vertices_.push_back({{x0, y1}, sdl_color, {u0, v1}});
+  for (const int i : {0, 1, 2, 0, 2, 3})
+  {
+    indices_.push_back(first + i);
+  }
+  stats_.batched_quads++;
+}
+
+void RenderContext::flush()
+{
+  if (vertices_.empty())
+  {
+    return;
+  }
+  if (SDL_RenderGeometry(&sdl_renderer_,
+                         texture_,
+                         vertices_.data(),
+                         static_cast<int>(vertices_.size()),
+                         indices_.data(),
+                         static_cast<int>(indices_.size())) != 0)
+  {
+    LOG_ERROR("Could not render geometry: %s", SDL_GetError());
+  }
+  stats_.draw_calls++;
+  vertices_.clear();
+  indices_.clear();
+}
+
+#else
+
+// SDL_RenderGeometry needs SDL 2.0.18, older versions draw batched blits right away, see SurfaceImpl::blit_batched
+void RenderContext::add_quad(SDL_Texture*, const geometry::Size&, const geometry::Rectangle&, const geometry::Rectangle&, const bool, const Color)
+{
+}
+
+void RenderContext::flush() {}
+
+#endif
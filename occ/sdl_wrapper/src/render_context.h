@@ -0,0 +1,58 @@
+#pragma once
+
+#include <vector>
+
+#include <SDL.h>
+
+#include "geometry.h"
+#include "graphics.h"
+
+/// Renderer state shared by a Window and its Surfaces
+/// Tracks the current renderer state so redundant state changes are skipped, and counts them in RenderStats.
+/// Batched blits are collected as textured quads and drawn with one SDL_RenderGeometry call per texture.
+class RenderContext
+{
+ public:
+  explicit RenderContext(SDL_Renderer& sdl_renderer) : sdl_renderer_(sdl_renderer) {}
+
+  SDL_Renderer& get_renderer() const { return sdl_renderer_; }
+
+  // surface is the Surface owning texture, or nullptr for the window
+  void set_render_target(Surface* surface, SDL_Texture* texture);
+  Surface* get_render_target() const { return render_target_surface_; }
+  void set_draw_color(const Color& color);
+  // current is the color mod the texture has now, owned by the surface
+  void set_color_mod(SDL_Texture* texture, Color& current, const Color& color);
+  void set_blend_mode(SDL_Texture* texture, SDL_BlendMode blend_mode);
+  void count_draw_call() { stats_.draw_calls++; }
+  // Must be called before a texture is destroyed
+  void release_texture(SDL_Texture* texture);
+
+  void add_quad(SDL_Texture* texture,
+                const geometry::Size& texture_size,
+                const geometry::Rectangle& source,
+                const geometry::Rectangle& dest,
+                const bool flip,
+                const Color color);
+
+  // Draws the queued quads; must be called before anything is drawn without batching
+  void flush();
+
+  // Ends the frame: the current stats become the last frame stats
+  void end_frame();
+  const RenderStats& get_last_frame_stats() const { return last_frame_stats_; }
+
+ private:
+  SDL_Renderer& sdl_renderer_;
+  SDL_Texture* render_target_ = nullptr;
+  Surface* render_target_surface_ = nullptr;
+  Color draw_color_;
+  bool draw_color_valid_ = false;
+
+  SDL_Texture* texture_ = nullptr;
+  std::vector<SDL_Vertex> vertices_;
+  std::vector<int> indices_;
+
+  RenderStats stats_;
+  RenderStats last_frame_stats_;
+};
@@ -25,10 +25,10 @@ void quit()
   SDL_Quit();
 }
 
-bool SDLWrapperImpl::init()
+bool SDLWrapperImpl::init(const bool headless)
 {
   // Init SDL
-  if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) < 0)
+  if (SDL_Init((headless ? SDL_INIT_EVENTS : SDL_INIT_VIDEO) | SDL_INIT_AUDIO) < 0)
   {
     LOG_CRITICAL("Could not initialize SDL: %s", SDL_GetError());
     return false;
@@ -49,6 +49,16 @@ unsigned SDLWrapperImpl::get_tick()
   return SDL_GetTicks();
 }
 
+uint64_t SDLWrapperImpl::get_performance_counter()
+{
+  return SDL_GetPerformanceCounter();
+}
+
+uint64_t SDLWrapperImpl::get_performance_frequency()
+{
+  return SDL_GetPerformanceFrequency();
+}
+
 void SDLWrapperImpl::delay(const int ms)
 {
   SDL_Delay(ms);
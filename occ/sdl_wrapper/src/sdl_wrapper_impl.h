@@ -4,7 +4,9 @@
 class SDLWrapperImpl : public SDLWrapper
 {
  public:
-  bool init() override;
+  bool init(const bool headless = false) override;
   unsigned get_tick() override;
+  uint64_t get_performance_counter() override;
+  uint64_t get_performance_frequency() override;
   void delay(const int ms) override;
 };
\ No newline at end of file
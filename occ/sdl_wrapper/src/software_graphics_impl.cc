@@ -0,0 +1,273 @@
+#include "software_graphics_impl.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#include <SDL.h>
+
+#include "graphics_impl.h"
+#include "logger.h"
+
+namespace
+{
+
+constexpr uint32_t to_pixel(const Color& color)
+{
+  return (static_cast<uint32_t>(color.alpha) << 24) | (static_cast<uint32_t>(color.red) << 16) | (static_cast<uint32_t>(color.green) << 8) |
+         static_cast<uint32_t>(color.blue);
+}
+
+// a * b / 255, rounded
+constexpr uint32_t mul8(const uint32_t a, const uint32_t b)
+{
+  return (a * b + 127u) / 255u;
+}
+
+// dst = src * a + dst * (1 - a), same as SDL_BLENDMODE_BLEND
+uint32_t blend(const uint32_t src, const uint32_t dst)
+{
+  const auto a = src >> 24;
+  if (a == 0xffu)
+  {
+    return src;
+  }
+  if (a == 0u)
+  {
+    return dst;
+  }
+  const auto channel = [a](const uint32_t s, const uint32_t d) { return mul8(s, a) + mul8(d, 0xffu - a); };
+  const auto out_a = a + mul8(dst >> 24, 0xffu - a);
+  const auto out_r = channel((src >> 16) & 0xffu, (dst >> 16) & 0xffu);
+  const auto out_g = channel((src >> 8) & 0xffu, (dst >> 8) & 0xffu);
+  const auto out_b = channel(src & 0xffu, dst & 0xffu);
+  return (out_a << 24) | (out_r << 16) | (out_g << 8) | out_b;
+}
+
+}  // namespace
+
+std::unique_ptr<Window> Window::create_software(geometry::Size size)
+{
+  return std::make_unique<SoftwareWindowImpl>(size);
+}
+
+SoftwareWindowImpl::SoftwareWindowImpl(geometry::Size size) : size_(size), framebuffer_(size.x() * size.y(), to_pixel({0, 0, 0, 0xff})) {}
+
+void SoftwareWindowImpl::set_size(geometry::Size size)
+{
+  size_ = size;
+  framebuffer_.assign(size.x() * size.y(), to_pixel({0, 0, 0, 0xff}));
+}
+
+void SoftwareWindowImpl::set_render_target(Surface* surface)
+{
+  auto* target = static_cast<SoftwareSurfaceImpl*>(surface);
+  if (target == render_target_)
+  {
+    return;
+  }
+  render_target_ = target;
+  stats_.render_target_changes++;
+}
+
+Surface* SoftwareWindowImpl::get_render_target() const
+{
+  return render_target_;
+}
+
+std::unique_ptr<Surface> SoftwareWindowImpl::create_target_surface(geometry::Size size)
+{
+  // Target textures start out transparent black
+  return std::make_unique<SoftwareSurfaceImpl>(size.x(), size.y(), std::vector<uint32_t>(size.x() * size.y(), 0u), *this);
+}
+
+std::unique_ptr<Surface> SoftwareWindowImpl::create_surface(const Image& image)
+{
+  auto sdl_surface = std::unique_ptr<SDL_Surface, decltype(&SDL_FreeSurface)>(
+    SDL_ConvertSurfaceFormat(static_cast<const ImageImpl&>(image).get_surface(), SDL_PIXELFORMAT_ARGB8888, 0), SDL_FreeSurface);
+  if (!sdl_surface)
+  {
+    LOG_CRITICAL("Could not convert surface: %s", SDL_GetError());
+    return std::unique_ptr<Surface>();
+  }
+  std::vector<uint32_t> pixels(sdl_surface->w * sdl_surface->h);
+  SDL_LockSurface(sdl_surface.get());
+  for (int y = 0; y < sdl_surface->h; y++)
+  {
+    memcpy(pixels.data() + y * sdl_surface->w,
+           static_cast<const uint8_t*>(sdl_surface->pixels) + y * sdl_surface->pitch,
+           sdl_surface->w * sizeof(uint32_t));
+  }
+  SDL_UnlockSurface(sdl_surface.get());
+  return std::make_unique<SoftwareSurfaceImpl>(sdl_surface->w, sdl_surface->h, std::move(pixels), *this);
+}
+
+void SoftwareWindowImpl::refresh()
+{
+  last_frame_stats_ = stats_;
+  stats_ = RenderStats();
+}
+
+void SoftwareWindowImpl::fill_rect(const geometry::Rectangle& rect, const Color& color)
+{
+  // The draw blend mode is never changed from SDL_BLENDMODE_NONE, so fills overwrite
+  const auto target = get_target();
+  const auto pixel = to_pixel(color);
+  const auto x0 = std::max(rect.position.x(), 0);
+  const auto x1 = std::min(rect.position.x() + rect.size.x(), target.size.x());
+  const auto y0 = std::max(rect.position.y(), 0);
+  const auto y1 = std::min(rect.position.y() + rect.size.y(), target.size.y());
+  for (int y = y0; y < y1; y++)
+  {
+    std::fill(target.pixels.begin() + y * target.size.x() + x0, target.pixels.begin() + y * target.size.x() + std::max(x0, x1), pixel);
+  }
+  stats_.draw_calls++;
+}
+
+void SoftwareWindowImpl::render_line(const geometry::Position& from, const geometry::Position& to, const Color& color)
+{
+  const auto target = get_target();
+  const auto pixel = to_pixel({color.red, color.green, color.blue, 0xff});
+  // Bresenham
+  int x = from.x();
+  int y = from.y();
+  const int dx = std::abs(to.x() - x);
+  const int dy = -std::abs(to.y() - y);
+  const int step_x = x < to.x() ? 1 : -1;
+  const int step_y = y < to.y() ? 1 : -1;
+  int error = dx + dy;
+  while (true)
+  {
+    set_pixel(target, x, y, pixel);
+    if (x == to.x() && y == to.y())
+    {
+      break;
+    }
+    const int error2 = 2 * error;
+    if (error2 >= dy)
+    {
+      error += dy;
+      x += step_x;
+    }
+    if (error2 <= dx)
+    {
+      error += dx;
+      y += step_y;
+    }
+  }
+  stats_.draw_calls++;
+}
+
+void SoftwareWindowImpl::render_rectangle(const geometry::Rectangle& rect, const Color& color)
+{
+  const auto right = rect.position.x() + rect.size.x() - 1;
+  const auto bottom = rect.position.y() + rect.size.y() - 1;
+  render_line(rect.position, geometry::Position(right, rect.position.y()), color);
+  render_line(geometry::Position(rect.position.x(), bottom), geometry::Position(right, bottom), color);
+  render_line(rect.position, geometry::Position(rect.position.x(), bottom), color);
+  render_line(geometry::Position(right, rect.position.y()), geometry::Position(right, bottom), color);
+}
+
+void SoftwareWindowImpl::blit_batched(const Surface& surface,
+                                      const geometry::Rectangle& source,
+                                      const geometry::Rectangle& dest,
+                                      const bool flip,
+                                      const Color color)
+{
+  blit(static_cast<const SoftwareSurfaceImpl&>(surface), source, dest, flip, color);
+}
+
+bool SoftwareWindowImpl::read_pixels(std::vector<uint32_t>& pixels)
+{
+  pixels = get_target().pixels;
+  return true;
+}
+
+void SoftwareWindowImpl::blit(const SoftwareSurfaceImpl& surface,
+                              const geometry::Rectangle& source,
+                              const geometry::Rectangle& dest,
+                              const bool flip,
+                              const Color& tint)
+{
+  stats_.draw_calls++;
+  if (dest.size.x() <= 0 || dest.size.y() <= 0 || source.size.x() <= 0 || source.size.y() <= 0)
+  {
+    return;
+  }
+  const auto target = get_target();
+  const auto& src_pixels = surface.get_pixels();
+  const auto alpha = surface.get_alpha();
+  const auto x0 = std::max(dest.position.x(), 0);
+  const auto x1 = std::min(dest.position.x() + dest.size.x(), target.size.x());
+  const auto y0 = std::max(dest.position.y(), 0);
+  const auto y1 = std::min(dest.position.y() + dest.size.y(), target.size.y());
+  for (int y = y0; y < y1; y++)
+  {
+    // Nearest neighbour scaling, sampled at the pixel centre like SDL does
+    const auto sy = source.position.y() + ((y - dest.position.y()) * 2 + 1) * source.size.y() / (dest.size.y() * 2);
+    if (sy < 0 || sy >= surface.height())
+    {
+      continue;
+    }
+    for (int x = x0; x < x1; x++)
+    {
+      auto u = ((x - dest.position.x()) * 2 + 1) * source.size.x() / (dest.size.x() * 2);
+      if (flip)
+      {
+        u = source.size.x() - 1 - u;
+      }
+      const auto sx = source.position.x() + u;
+      if (sx < 0 || sx >= surface.width())
+      {
+        continue;
+      }
+      const auto src = src_pixels[sy * surface.width() + sx];
+      const auto src_a = mul8(src >> 24, alpha);
+      const auto src_r = mul8((src >> 16) & 0xffu, tint.red);
+      const auto src_g = mul8((src >> 8) & 0xffu, tint.green);
+      const auto src_b = mul8(src & 0xffu, tint.blue);
+      auto& dst = target.pixels[y * target.size.x() + x];
+      dst = blend((src_a << 24) | (src_r << 16) | (src_g << 8) | src_b, dst);
+    }
+  }
+}
+
+geometry::Size SoftwareWindowImpl::get_target_size() const
+{
+  return render_target_ ? render_target_->size() : size_;
+}
+
+void SoftwareWindowImpl::release_surface(const SoftwareSurfaceImpl* surface)
+{
+  if (surface == render_target_)
+  {
+    render_target_ = nullptr;
+  }
+}
+
+SoftwareWindowImpl::Target SoftwareWindowImpl::get_target()
+{
+  if (render_target_)
+  {
+    return {render_target_->get_pixels(), render_target_->size()};
+  }
+  return {framebuffer_, size_};
+}
+
+void SoftwareWindowImpl::set_pixel(const Target& target, const int x, const int y, const uint32_t pixel)
+{
+  if (x >= 0 && y >= 0 && x < target.size.x() && y < target.size.y())
+  {
+    target.pixels[y * target.size.x() + x] = pixel;
+  }
+}
+
+void SoftwareSurfaceImpl::blit_surface(const geometry::Rectangle& source, const geometry::Rectangle& dest, const bool flip, const Color color) const
+{
+  window_.blit(*this, source, dest, flip, color);
+}
+
+void SoftwareSurfaceImpl::blit_surface() const
+{
+  window_.blit(*this, geometry::Rectangle(0, 0, size()), geometry::Rectangle(0, 0, window_.get_target_size()), false, {0xff, 0xff, 0xff});
+}
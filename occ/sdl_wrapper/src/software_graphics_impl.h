@@ -0,0 +1,100 @@
+#pragma once
+
+#include "graphics.h"
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "geometry.h"
+
+class SoftwareSurfaceImpl;
+
+/// Window that renders into an ARGB8888 framebuffer in CPU memory
+/// Blending matches the SDL renderer: fills and lines overwrite, blits blend with the surface alpha
+class SoftwareWindowImpl : public Window
+{
+ public:
+  explicit SoftwareWindowImpl(geometry::Size size);
+
+  void set_size(geometry::Size size) override;
+  // There is no display to wait for
+  bool set_vsync(const bool vsync) override { return !vsync; }
+  int get_refresh_rate() const override { return 0; }
+  void set_render_target(Surface* surface) override;
+  Surface* get_render_target() const override;
+  std::unique_ptr<Surface> create_target_surface(geometry::Size size) override;
+  std::unique_ptr<Surface> create_surface(const Image& image) override;
+  void refresh() override;
+  void fill_rect(const geometry::Rectangle& rect, const Color& color) override;
+  void render_line(const geometry::Position& from, const geometry::Position& to, const Color& color) override;
+  void render_rectangle(const geometry::Rectangle& rect, const Color& color) override;
+  void blit_batched(const Surface& surface,
+                    const geometry::Rectangle& source,
+                    const geometry::Rectangle& dest,
+                    const bool flip = false,
+                    const Color color = {0xff, 0xff, 0xff}) override;
+  // Blits are drawn right away, nothing is queued
+  void flush() override {}
+  const RenderStats& get_render_stats() const override { return last_frame_stats_; }
+  bool read_pixels(std::vector<uint32_t>& pixels) override;
+
+  void blit(const SoftwareSurfaceImpl& surface,
+            const geometry::Rectangle& source,
+            const geometry::Rectangle& dest,
+            const bool flip,
+            const Color& tint);
+  geometry::Size get_target_size() const;
+  // Called when a surface is destroyed so that it is no longer the render target
+  void release_surface(const SoftwareSurfaceImpl* surface);
+
+ private:
+  struct Target
+  {
+    std::vector<uint32_t>& pixels;
+    geometry::Size size;
+  };
+  Target get_target();
+  static void set_pixel(const Target& target, const int x, const int y, const uint32_t pixel);
+
+  geometry::Size size_;
+  std::vector<uint32_t> framebuffer_;
+  SoftwareSurfaceImpl* render_target_ = nullptr;
+  RenderStats stats_;
+  RenderStats last_frame_stats_;
+};
+
+class SoftwareSurfaceImpl : public Surface
+{
+ public:
+  SoftwareSurfaceImpl(const int w, const int h, std::vector<uint32_t> pixels, SoftwareWindowImpl& window)
+    : w_(w),
+      h_(h),
+      pixels_(std::move(pixels)),
+      window_(window)
+  {
+  }
+  ~SoftwareSurfaceImpl() override { window_.release_surface(this); }
+
+  int width() const override { return w_; }
+  int height() const override { return h_; }
+
+  void blit_surface(const geometry::Rectangle& source,
+                    const geometry::Rectangle& dest,
+                    const bool flip = false,
+                    const Color color = {0xff, 0xff, 0xff}) const override;
+  void blit_surface() const override;
+  void set_alpha(const uint8_t alpha) override { alpha_ = alpha; }
+
+  uint8_t get_alpha() const { return alpha_; }
+  std::vector<uint32_t>& get_pixels() { return pixels_; }
+  const std::vector<uint32_t>& get_pixels() const { return pixels_; }
+
+ private:
+  int w_;
+  int h_;
+  std::vector<uint32_t> pixels_;
+  SoftwareWindowImpl& window_;
+  uint8_t alpha_ = 0xff;
+};
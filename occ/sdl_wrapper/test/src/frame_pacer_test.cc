@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include "frame_pacer.h"
+#include "sdl_wrapper.h"
+
+class FakeClock : public SDLWrapper
+{
+ public:
+  bool init(const bool) override { return true; }
+  unsigned get_tick() override { return static_cast<unsigned>(counter / 1000u); }
+  uint64_t get_performance_counter() override
+  {
+    // Spinning takes time as well
+    return counter++;
+  }
+  uint64_t get_performance_frequency() override { return 1000000u; }
+  void delay(const int ms) override
+  {
+    counter += ms * 1000u;
+    delays++;
+  }
+
+  uint64_t counter = 0;
+  int delays = 0;
+};
+
+TEST(FramePacer, ticks_do_not_drift)
+{
+  FakeClock clock;
+  // 17.5 ticks per second, 57142.857... us per tick
+  FramePacer pacer(clock, 70, 4);
+  unsigned ticks = 0;
+  while (clock.counter < 4000000u)
+  {
+    clock.counter += 1000u;
+    ticks += pacer.advance();
+  }
+  EXPECT_EQ(70u, ticks);
+}
+
+TEST(FramePacer, catch_up_is_bounded)
+{
+  FakeClock clock;
+  FramePacer pacer(clock, 10, 1, 3);
+  clock.counter += 10000000u;
+  EXPECT_EQ(3u, pacer.advance());
+  // The rest of the backlog is dropped
+  EXPECT_EQ(0u, pacer.advance());
+  clock.counter += 100000u;
+  EXPECT_EQ(1u, pacer.advance());
+}
+
+TEST(FramePacer, time_scale)
+{
+  FakeClock clock;
+  FramePacer pacer(clock, 10, 1, 3);
+  pacer.set_time_scale(4);
+  clock.counter += 1000000u;
+  // 40 ticks are due, but catch-up is limited to 3 ticks per frame at 1x
+  EXPECT_EQ(12u, pacer.advance());
+  clock.counter += 25000u;
+  EXPECT_EQ(1u, pacer.advance());
+
+  // Uncapped doesn't wait
+  pacer.set_time_scale(0);
+  const auto counter = clock.counter;
+  pacer.wait_for_tick();
+  EXPECT_EQ(0, clock.delays);
+  EXPECT_LT(clock.counter, counter + 10u);
+  EXPECT_GT(pacer.advance(), 1u);
+}
+
+TEST(FramePacer, time_scale_change_keeps_elapsed_time)
+{
+  FakeClock clock;
+  FramePacer pacer(clock, 10, 1, 100);
+  pacer.advance();
+  // Half a tick at 1x, then 8x: the half tick is not sped up
+  clock.counter += 50000u;
+  pacer.set_time_scale(8);
+  EXPECT_EQ(0u, pacer.advance());
+  clock.counter += 6250u;
+  EXPECT_EQ(1u, pacer.advance());
+
+  // And back: the time at 8x is not slowed down
+  clock.counter += 12500u;
+  pacer.set_time_scale(1);
+  EXPECT_EQ(1u, pacer.advance());
+}
+
+TEST(FramePacer, wait_sleeps_then_spins)
+{
+  FakeClock clock;
+  FramePacer pacer(clock, 10, 1);
+  pacer.wait_for_tick();
+  EXPECT_GE(clock.counter, 100000u);
+  // Woke up less than the spin time before the tick and spun the rest
+  EXPECT_LT(clock.counter, 100010u);
+  EXPECT_EQ(1, clock.delays);
+  EXPECT_EQ(1u, pacer.advance());
+  EXPECT_LT(pacer.get_alpha(), 0.01f);
+}
+
+TEST(FramePacer, fps)
+{
+  FakeClock clock;
+  FramePacer pacer(clock, 10, 1);
+  for (int i = 0; i < 120; i++)
+  {
+    clock.counter += 10000u;
+    pacer.count_frame();
+  }
+  EXPECT_NEAR(100.0f, pacer.get_fps(), 1.0f);
+}
+
+TEST(FramePacer, outpaces_display)
+{
+  FakeClock clock;
+  FramePacer pacer(clock, 10, 1);
+  EXPECT_FALSE(pacer.outpaces_display(60));
+  // 1000 fps
+  for (int i = 0; i < 1200; i++)
+  {
+    clock.counter += 1000u;
+    pacer.count_frame();
+  }
+  EXPECT_TRUE(pacer.outpaces_display(60));
+  EXPECT_TRUE(pacer.outpaces_display(0));
+  EXPECT_FALSE(pacer.outpaces_display(600));
+}
@@ -14,6 +14,9 @@ struct SDL_Window
 struct SDL_Renderer
 {
 };
+struct SDL_Texture
+{
+};
 
 class GraphicsTest : public ::testing::Test
 {
@@ -86,3 +89,149 @@ TEST_F(GraphicsTest, surface_fill_rect)
   EXPECT_CALL(SDLStub::get(), SDL_DestroyRenderer(&sdl_renderer));
   window.reset();
 }
+
+TEST_F(GraphicsTest, surface_from_image_data)
+{
+  SDL_Window sdl_window;
+  EXPECT_CALL(SDLStub::get(), SDL_CreateWindow(_, _, _, _, _, _)).WillOnce(Return(&sdl_window));
+  SDL_Renderer sdl_renderer;
+  EXPECT_CALL(SDLStub::get(), SDL_CreateRenderer(_, _, _)).WillOnce(Return(&sdl_renderer));
+  auto window = Window::create("test", geometry::Size(100, 100), "");
+
+  // Decoding an image does not touch the renderer
+  SDL_Surface sdl_surface;
+  sdl_surface.w = 16;
+  sdl_surface.h = 8;
+  EXPECT_CALL(SDLStub::get(), SDL_CreateRGBSurfaceWithFormat(_, 16, 8, 32, _)).WillOnce(Return(&sdl_surface));
+  EXPECT_CALL(SDLStub::get(), SDL_CreateTextureFromSurface(_, _)).Times(0);
+  auto image = Image::from_pixels(16, 8, nullptr);
+  ASSERT_TRUE(image);
+  EXPECT_EQ(16, image->width());
+  EXPECT_EQ(8, image->height());
+
+  EXPECT_CALL(SDLStub::get(), SDL_CreateTextureFromSurface(&sdl_renderer, &sdl_surface)).WillOnce(Return(nullptr));
+  EXPECT_FALSE(Surface::from_image_data(*image, *window));
+
+  EXPECT_CALL(SDLStub::get(), SDL_FreeSurface(&sdl_surface));
+  image.reset();
+}
+
+TEST_F(GraphicsTest, window_blit_batched)
+{
+  SDL_Window sdl_window;
+  EXPECT_CALL(SDLStub::get(), SDL_CreateWindow(_, _, _, _, _, _)).WillOnce(Return(&sdl_window));
+  SDL_Renderer sdl_renderer;
+  EXPECT_CALL(SDLStub::get(), SDL_CreateRenderer(_, _, _)).WillOnce(Return(&sdl_renderer));
+  auto window = Window::create("test", geometry::Size(100, 100), "");
+
+  SDL_Texture sdl_texture_1;
+  SDL_Texture sdl_texture_2;
+  EXPECT_CALL(SDLStub::get(), SDL_CreateTexture(&sdl_renderer, _, _, 16, 16))
+    .WillOnce(Return(&sdl_texture_1))
+    .WillOnce(Return(&sdl_texture_2));
+  auto surface_1 = window->create_target_surface({16, 16});
+  auto surface_2 = window->create_target_surface({16, 16});
+
+  // Nothing is drawn until the batch is flushed
+  EXPECT_CALL(SDLStub::get(), SDL_RenderGeometry(_, _, _, _, _, _)).Times(0);
+  window->blit_batched(*surface_1, {0, 0, 8, 8}, {0, 0, 8, 8});
+  window->blit_batched(*surface_1, {8, 8, 8, 8}, {8, 0, 8, 8}, true);
+  ::testing::Mock::VerifyAndClearExpectations(&SDLStub::get());
+
+  // Changing texture draws the queued quads in one call
+  EXPECT_CALL(SDLStub::get(), SDL_RenderGeometry(&sdl_renderer, &sdl_texture_1, _, 8, _, 12)).WillOnce(Return(0));
+  window->blit_batched(*surface_2, {0, 0, 8, 8}, {0, 8, 8, 8});
+  ::testing::Mock::VerifyAndClearExpectations(&SDLStub::get());
+
+  // Anything drawn without batching flushes first
+  {
+    ::testing::InSequence sequence;
+    EXPECT_CALL(SDLStub::get(), SDL_RenderGeometry(&sdl_renderer, &sdl_texture_2, _, 4, _, 6)).WillOnce(Return(0));
+    EXPECT_CALL(SDLStub::get(), SDL_RenderFillRect(&sdl_renderer, _));
+  }
+  window->fill_rect(geometry::Rectangle(0, 0, 100, 100), {0u, 0u, 0u});
+  ::testing::Mock::VerifyAndClearExpectations(&SDLStub::get());
+
+  EXPECT_CALL(SDLStub::get(), SDL_RenderGeometry(_, _, _, _, _, _)).Times(0);
+  window->flush();
+
+  surface_1.reset();
+  surface_2.reset();
+  window.reset();
+}
+
+TEST_F(GraphicsTest, surface_destroy_flushes_its_quads)
+{
+  SDL_Window sdl_window;
+  EXPECT_CALL(SDLStub::get(), SDL_CreateWindow(_, _, _, _, _, _)).WillOnce(Return(&sdl_window));
+  SDL_Renderer sdl_renderer;
+  EXPECT_CALL(SDLStub::get(), SDL_CreateRenderer(_, _, _)).WillOnce(Return(&sdl_renderer));
+  auto window = Window::create("test", geometry::Size(100, 100), "");
+  SDL_Texture sdl_texture;
+  EXPECT_CALL(SDLStub::get(), SDL_CreateTexture(&sdl_renderer, _, _, 16, 16)).WillOnce(Return(&sdl_texture));
+  auto surface = window->create_target_surface({16, 16});
+
+  // Queued quads are drawn before their texture is destroyed, and nothing refers to it afterwards
+  window->blit_batched(*surface, {0, 0, 8, 8}, {0, 0, 8, 8});
+  {
+    ::testing::InSequence sequence;
+    EXPECT_CALL(SDLStub::get(), SDL_RenderGeometry(&sdl_renderer, &sdl_texture, _, 4, _, 6)).WillOnce(Return(0));
+    EXPECT_CALL(SDLStub::get(), SDL_DestroyTexture(&sdl_texture));
+  }
+  surface.reset();
+  ::testing::Mock::VerifyAndClearExpectations(&SDLStub::get());
+
+  EXPECT_CALL(SDLStub::get(), SDL_RenderGeometry(_, _, _, _, _, _)).Times(0);
+  window->flush();
+  window.reset();
+}
+
+TEST_F(GraphicsTest, window_render_rectangle_sets_draw_color_once)
+{
+  SDL_Window sdl_window;
+  EXPECT_CALL(SDLStub::get(), SDL_CreateWindow(_, _, _, _, _, _)).WillOnce(Return(&sdl_window));
+  SDL_Renderer sdl_renderer;
+  EXPECT_CALL(SDLStub::get(), SDL_CreateRenderer(_, _, _)).WillOnce(Return(&sdl_renderer));
+  auto window = Window::create("test", geometry::Size(100, 100), "");
+
+  EXPECT_CALL(SDLStub::get(), SDL_SetRenderDrawColor(&sdl_renderer, 255, 0, 0, 255)).WillOnce(Return(0));
+  EXPECT_CALL(SDLStub::get(), SDL_RenderDrawLine(&sdl_renderer, _, _, _, _)).Times(8);
+  window->render_rectangle(geometry::Rectangle(0, 0, 10, 10), {255u, 0u, 0u});
+  window->render_rectangle(geometry::Rectangle(10, 10, 10, 10), {255u, 0u, 0u});
+  window->refresh();
+
+  const auto& stats = window->get_render_stats();
+  EXPECT_EQ(8u, stats.draw_calls);
+  EXPECT_EQ(1u, stats.draw_color_changes);
+
+  window.reset();
+}
+
+TEST_F(GraphicsTest, surface_blit_skips_redundant_color_mod)
+{
+  SDL_Window sdl_window;
+  EXPECT_CALL(SDLStub::get(), SDL_CreateWindow(_, _, _, _, _, _)).WillOnce(Return(&sdl_window));
+  SDL_Renderer sdl_renderer;
+  EXPECT_CALL(SDLStub::get(), SDL_CreateRenderer(_, _, _)).WillOnce(Return(&sdl_renderer));
+  auto window = Window::create("test", geometry::Size(100, 100), "");
+  SDL_Texture sdl_texture;
+  EXPECT_CALL(SDLStub::get(), SDL_CreateTexture(&sdl_renderer, _, _, 16, 16)).WillOnce(Return(&sdl_texture));
+  auto surface = window->create_target_surface({16, 16});
+  window->refresh();
+
+  // Tinting sets the color mod once, unflipped blits do not need SDL_RenderCopyEx
+  EXPECT_CALL(SDLStub::get(), SDL_SetTextureColorMod(&sdl_texture, 255, 0, 0)).WillOnce(Return(0));
+  EXPECT_CALL(SDLStub::get(), SDL_RenderCopy(&sdl_renderer, &sdl_texture, _, _)).Times(2).WillRepeatedly(Return(0));
+  EXPECT_CALL(SDLStub::get(), SDL_RenderCopyEx(&sdl_renderer, &sdl_texture, _, _, _, _, SDL_FLIP_HORIZONTAL)).WillOnce(Return(0));
+  surface->blit_surface({0, 0, 8, 8}, {0, 0, 8, 8}, false, {255u, 0u, 0u});
+  surface->blit_surface({0, 0, 8, 8}, {8, 0, 8, 8}, false, {255u, 0u, 0u});
+  surface->blit_surface({0, 0, 8, 8}, {16, 0, 8, 8}, true, {255u, 0u, 0u});
+  window->refresh();
+
+  const auto& stats = window->get_render_stats();
+  EXPECT_EQ(3u, stats.draw_calls);
+  EXPECT_EQ(1u, stats.color_mod_changes);
+
+  surface.reset();
+  window.reset();
+}
@@ -42,6 +42,17 @@ TEST_F(SDLWrapperTest, get_tick)
   EXPECT_EQ(tick, wrapper->get_tick());
 }
 
+TEST_F(SDLWrapperTest, get_performance_counter)
+{
+  auto wrapper = SDLWrapper::create();
+  ASSERT_TRUE(wrapper.get() != nullptr);
+
+  EXPECT_CALL(SDLStub::get(), SDL_GetPerformanceCounter()).WillOnce(Return(1234567890123u));
+  EXPECT_EQ(1234567890123u, wrapper->get_performance_counter());
+  EXPECT_CALL(SDLStub::get(), SDL_GetPerformanceFrequency()).WillOnce(Return(1000000000u));
+  EXPECT_EQ(1000000000u, wrapper->get_performance_frequency());
+}
+
 TEST_F(SDLWrapperTest, delay)
 {
   auto wrapper = SDLWrapper::create();
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "geometry.h"
+#include "graphics.h"
+
+TEST(SoftwareGraphicsTest, fill_rect)
+{
+  auto window = Window::create_software(geometry::Size(4, 2));
+  ASSERT_TRUE(window);
+
+  // Fills overwrite the target, including its alpha
+  window->fill_rect(geometry::Rectangle(1, 0, 2, 1), {0x11u, 0x22u, 0x33u});
+  window->fill_rect(geometry::Rectangle(3, 1, 5, 5), {0x44u, 0x55u, 0x66u, 0x80u});
+
+  std::vector<uint32_t> pixels;
+  ASSERT_TRUE(window->read_pixels(pixels));
+  const std::vector<uint32_t> golden = {
+    0xff000000u, 0xff112233u, 0xff112233u, 0xff000000u,
+    0xff000000u, 0xff000000u, 0xff000000u, 0x80445566u,
+  };
+  EXPECT_EQ(golden, pixels);
+}
+
+TEST(SoftwareGraphicsTest, render_rectangle)
+{
+  auto window = Window::create_software(geometry::Size(4, 4));
+  window->render_rectangle(geometry::Rectangle(0, 0, 4, 3), {0xffu, 0u, 0u, 0x10u});
+  window->render_line(geometry::Position(0, 3), geometry::Position(3, 3), {0u, 0xffu, 0u});
+
+  std::vector<uint32_t> pixels;
+  ASSERT_TRUE(window->read_pixels(pixels));
+  // Lines are always opaque
+  const auto r = 0xffff0000u;
+  const auto g = 0xff00ff00u;
+  const auto k = 0xff000000u;
+  const std::vector<uint32_t> golden = {
+    r, r, r, r,
+    r, k, k, r,
+    r, r, r, r,
+    g, g, g, g,
+  };
+  EXPECT_EQ(golden, pixels);
+}
+
+TEST(SoftwareGraphicsTest, blit_tinted_and_flipped)
+{
+  auto window = Window::create_software(geometry::Size(4, 2));
+
+  // Draw a 2x1 atlas: opaque white and half transparent white
+  auto atlas = window->create_target_surface(geometry::Size(2, 1));
+  ASSERT_TRUE(atlas);
+  window->set_render_target(atlas.get());
+  EXPECT_EQ(atlas.get(), window->get_render_target());
+  window->fill_rect(geometry::Rectangle(0, 0, 1, 1), {0xffu, 0xffu, 0xffu});
+  window->fill_rect(geometry::Rectangle(1, 0, 1, 1), {0xffu, 0xffu, 0xffu, 0x80u});
+  window->set_render_target(nullptr);
+
+  window->blit_batched(*atlas, geometry::Rectangle(0, 0, 2, 1), geometry::Rectangle(0, 0, 2, 1), false, {0xffu, 0u, 0u});
+  // Scaled up and flipped
+  window->blit_batched(*atlas, geometry::Rectangle(0, 0, 2, 1), geometry::Rectangle(0, 1, 4, 1), true, {0u, 0u, 0xffu});
+  window->flush();
+
+  std::vector<uint32_t> pixels;
+  ASSERT_TRUE(window->read_pixels(pixels));
+  const std::vector<uint32_t> golden = {
+    0xffff0000u, 0xff800000u, 0xff000000u, 0xff000000u,
+    0xff000080u, 0xff000080u, 0xff0000ffu, 0xff0000ffu,
+  };
+  EXPECT_EQ(golden, pixels);
+
+  const auto& stats = window->get_render_stats();
+  EXPECT_EQ(0u, stats.draw_calls);
+  window->refresh();
+  EXPECT_EQ(4u, window->get_render_stats().draw_calls);
+  EXPECT_EQ(2u, window->get_render_stats().render_target_changes);
+}
+
+TEST(SoftwareGraphicsTest, surface_alpha)
+{
+  auto window = Window::create_software(geometry::Size(1, 1));
+  auto surface = window->create_target_surface(geometry::Size(1, 1));
+  window->set_render_target(surface.get());
+  window->fill_rect(geometry::Rectangle(0, 0, 1, 1), {0xffu, 0xffu, 0xffu});
+  window->set_render_target(nullptr);
+
+  surface->set_alpha(0x40u);
+  surface->blit_surface();
+
+  std::vector<uint32_t> pixels;
+  ASSERT_TRUE(window->read_pixels(pixels));
+  EXPECT_EQ(std::vector<uint32_t>{0xff404040u}, pixels);
+}
@@ -41,6 +41,16 @@ Uint32 SDL_GetTicks()
   return SDLStub::get().SDL_GetTicks();
 }
 
+Uint64 SDL_GetPerformanceCounter()
+{
+  return SDLStub::get().SDL_GetPerformanceCounter();
+}
+
+Uint64 SDL_GetPerformanceFrequency()
+{
+  return SDLStub::get().SDL_GetPerformanceFrequency();
+}
+
 SDL_Window* SDL_CreateWindow(const char* title, int x, int y, int w, int h, Uint32 flags)
 {
   return SDLStub::get().SDL_CreateWindow(title, x, y, w, h, flags);
@@ -196,6 +206,27 @@ int SDL_RenderCopy(SDL_Renderer* renderer, SDL_Texture* texture, const SDL_Rect*
   return SDLStub::get().SDL_RenderCopy(renderer, texture, srcrect, dstrect);
 }
 
+int SDL_RenderCopyEx(SDL_Renderer* renderer,
+                     SDL_Texture* texture,
+                     const SDL_Rect* srcrect,
+                     const SDL_Rect* dstrect,
+                     const double angle,
+                     const SDL_Point* center,
+                     const SDL_RendererFlip flip)
+{
+  return SDLStub::get().SDL_RenderCopyEx(renderer, texture, srcrect, dstrect, angle, center, flip);
+}
+
+int SDL_RenderGeometry(SDL_Renderer* renderer,
+                       SDL_Texture* texture,
+                       const SDL_Vertex* vertices,
+                       int num_vertices,
+                       const int* indices,
+                       int num_indices)
+{
+  return SDLStub::get().SDL_RenderGeometry(renderer, texture, vertices, num_vertices, indices, num_indices);
+}
+
 int SDL_PollEvent(SDL_Event* event)
 {
   return SDLStub::get().SDL_PollEvent(event);
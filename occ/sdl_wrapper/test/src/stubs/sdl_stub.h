@@ -10,6 +10,8 @@ class SDLStub
   MOCK_METHOD1(SDL_Init, int(Uint32));
   MOCK_METHOD0(SDL_GetError, const char*());
   MOCK_METHOD0(SDL_GetTicks, Uint32());
+  MOCK_METHOD0(SDL_GetPerformanceCounter, Uint64());
+  MOCK_METHOD0(SDL_GetPerformanceFrequency, Uint64());
 	MOCK_METHOD1(SDL_Delay, void(Uint32));
   MOCK_METHOD6(SDL_CreateWindow, SDL_Window*(const char*, int, int, int, int, Uint32));
   MOCK_METHOD3(SDL_CreateRenderer, SDL_Renderer*(SDL_Window*, int, Uint32));
@@ -42,6 +44,9 @@ class SDLStub
   MOCK_METHOD2(SDL_SetTextureBlendMode, int(SDL_Texture*, SDL_BlendMode));
   MOCK_METHOD4(SDL_SetTextureColorMod, int(SDL_Texture*, Uint8, Uint8, Uint8));
   MOCK_METHOD4(SDL_RenderCopy, int(SDL_Renderer*, SDL_Texture*, const SDL_Rect*, const SDL_Rect*));
+  MOCK_METHOD7(SDL_RenderCopyEx,
+               int(SDL_Renderer*, SDL_Texture*, const SDL_Rect*, const SDL_Rect*, const double, const SDL_Point*, const SDL_RendererFlip));
+  MOCK_METHOD6(SDL_RenderGeometry, int(SDL_Renderer*, SDL_Texture*, const SDL_Vertex*, int, const int*, int));
 
   MOCK_METHOD1(SDL_PollEvent, int(SDL_Event*));
   MOCK_METHOD5(SDL_MapRGBA, Uint32(const SDL_PixelFormat*, Uint8, Uint8, Uint8, Uint8));
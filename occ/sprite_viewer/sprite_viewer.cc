@@ -15,11 +15,11 @@ https://moddingwiki.shikadi.net/wiki/ProGraphx_Toolbox_tileset_format
 #include "sdl_wrapper.h"
 #include "sprite.h"
 
-void draw(Window& window, const Surface& surface, const int page_index, int x, int y, const Input& input, SpriteManager& sprite_manager)
+void draw(Window& window, const int palette, int x, int y, const Input& input, SpriteManager& sprite_manager)
 {
+  const auto& surface = *sprite_manager.get_surface(palette);
   window.fill_rect(geometry::Rectangle(0, 0, geometry::Size{surface.width(), SPRITE_ROWS * SPRITE_H}), {33u, 33u, 33u});
-  surface.blit_surface({0, page_index * SPRITE_ROWS * SPRITE_H, surface.width(), SPRITE_ROWS * SPRITE_H},
-                       {0, 0, surface.width(), SPRITE_ROWS * SPRITE_H});
+  surface.blit_surface({0, 0, surface.width(), SPRITE_ROWS * SPRITE_H}, {0, 0, surface.width(), SPRITE_ROWS * SPRITE_H});
   // Show hovered sprite and draw its index
   const geometry::Rectangle rect{{x * SPRITE_W, y * SPRITE_H}, {SPRITE_W, SPRITE_H}};
   window.render_rectangle(rect, {255, 255, 255, 255});
@@ -73,8 +73,8 @@ int main(int argc, char* argv[])
     LOG_CRITICAL("Could not load tilesets");
     return 1;
   }
-  const auto surface = sprite_manager.get_surface();
-  const int pages = surface->height() / (SPRITE_H * SPRITE_ROWS);
+  // One page per palette
+  const int pages = sprite_manager.palette_count();
   auto event = Event::create();
   if (!event)
   {
@@ -115,7 +115,7 @@ int main(int argc, char* argv[])
     const int my = input.mouse.y() / SPRITE_H;
     if (mx != last_mx || my != last_my || index != last_index)
     {
-      draw(*window, *surface, index, mx, my, input, sprite_manager);
+      draw(*window, index, mx, my, input, sprite_manager);
       last_mx = mx;
       last_my = my;
       last_index = index;
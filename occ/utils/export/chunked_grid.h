@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/// 2D grid stored in square chunks of CHUNK_SIZE x CHUNK_SIZE cells
+/// A chunk is allocated when a value other than the fill value is first written to it, so chunks holding only the
+/// fill value take no memory; unwritten cells read as the fill value
+template <typename T, int CHUNK_BITS = 5>
+class ChunkedGrid
+{
+ public:
+  static constexpr int CHUNK_SIZE = 1 << CHUNK_BITS;
+
+  ChunkedGrid() = default;
+  ChunkedGrid(const int width, const int height, T fill = T())
+    : width_(width),
+      height_(height),
+      chunks_w_((width + CHUNK_SIZE - 1) >> CHUNK_BITS),
+      fill_(std::move(fill)),
+      chunks_(chunks_w_ * ((height + CHUNK_SIZE - 1) >> CHUNK_BITS))
+  {
+  }
+
+  int width() const { return width_; }
+  int height() const { return height_; }
+
+  // Cells outside the grid read as the fill value
+  const T& get(const int x, const int y) const
+  {
+    if (x < 0 || x >= width_ || y < 0 || y >= height_)
+    {
+      return fill_;
+    }
+    const auto& chunk = chunks_[chunk_index(x, y)];
+    return chunk ? (*chunk)[cell_index(x, y)] : fill_;
+  }
+
+  // Writes outside the grid are ignored
+  void set(const int x, const int y, T value)
+  {
+    if (x < 0 || x >= width_ || y < 0 || y >= height_)
+    {
+      return;
+    }
+    auto& chunk = chunks_[chunk_index(x, y)];
+    if (!chunk)
+    {
+      if (value == fill_)
+      {
+        return;
+      }
+      chunk = std::make_unique<Chunk>();
+      chunk->fill(fill_);
+      num_chunks_++;
+    }
+    (*chunk)[cell_index(x, y)] = std::move(value);
+  }
+
+  size_t num_chunks_in_memory() const { return num_chunks_; }
+
+ private:
+  using Chunk = std::array<T, CHUNK_SIZE * CHUNK_SIZE>;
+
+  int chunk_index(const int x, const int y) const { return (y >> CHUNK_BITS) * chunks_w_ + (x >> CHUNK_BITS); }
+  static int cell_index(const int x, const int y) { return ((y & (CHUNK_SIZE - 1)) << CHUNK_BITS) + (x & (CHUNK_SIZE - 1)); }
+
+  int width_ = 0;
+  int height_ = 0;
+  int chunks_w_ = 0;
+  T fill_ = T();
+  std::vector<std::unique_ptr<Chunk>> chunks_;
+  size_t num_chunks_ = 0;
+};
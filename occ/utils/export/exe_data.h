@@ -7,6 +7,8 @@ class ExeData
   // Crystal caves data from the .EXE file
  public:
   ExeData(const int episode);
+  // Without any data, for code that is given its levels some other way, e.g. tests
+  ExeData() = default;
 
   std::string data;
 };
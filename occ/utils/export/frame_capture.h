@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "geometry.h"
+
+/// Writes ARGB8888 frames to disk on a background thread
+/// Frames go through a fixed ring of buffers: if the writer falls behind, frames are dropped instead of blocking the caller
+class FrameCapture
+{
+ public:
+  enum class Format
+  {
+    PNG,  // Numbered files frame_000000.png, ... in the directory
+    Y4M,  // One uncompressed YUV 4:4:4 stream
+  };
+
+  // The format is Y4M if path has the extension .y4m, otherwise path is the PNG directory
+  // The frame rate is fps_num / fps_den frames per second
+  static std::unique_ptr<FrameCapture> create(const std::filesystem::path& path, geometry::Size size, unsigned fps_num, unsigned fps_den);
+
+  FrameCapture(const std::filesystem::path& path,
+               Format format,
+               geometry::Size size,
+               unsigned fps_num,
+               unsigned fps_den,
+               unsigned num_buffers = 4);
+  ~FrameCapture();
+
+  FrameCapture(const FrameCapture&) = delete;
+  FrameCapture& operator=(const FrameCapture&) = delete;
+
+  // Returns a free buffer of size.x() * size.y() pixels to fill, or nullptr if all buffers are queued
+  // Must be followed by submit() if not nullptr
+  std::vector<uint32_t>* acquire();
+  void submit();
+  // Blocks until all submitted frames have been written
+  void wait_idle();
+
+  unsigned frames_written() const { return frames_written_; }
+  unsigned frames_dropped() const { return frames_dropped_; }
+
+  // Exposed for testing, scratch is reused between frames
+  static void write_png(std::ostream& os, geometry::Size size, const uint32_t* pixels, std::vector<uint8_t>& scratch);
+  static void write_y4m_header(std::ostream& os, geometry::Size size, unsigned fps_num, unsigned fps_den);
+  static void write_y4m_frame(std::ostream& os, geometry::Size size, const uint32_t* pixels, std::vector<uint8_t>& scratch);
+
+ private:
+  void run();
+  void write(const std::vector<uint32_t>& pixels, unsigned frame);
+
+  std::filesystem::path path_;
+  Format format_;
+  geometry::Size size_;
+  std::ofstream stream_;
+  std::vector<uint8_t> scratch_;
+  std::vector<std::vector<uint32_t>> buffers_;
+  // Buffers [first_queued_, first_queued_ + num_queued_) are waiting to be written (or being written)
+  unsigned first_queued_ = 0;
+  unsigned num_queued_ = 0;
+  bool stopping_ = false;
+  std::atomic<unsigned> frames_written_ = 0;
+  std::atomic<unsigned> frames_dropped_ = 0;
+  std::mutex mutex_;
+  std::condition_variable frame_available_;
+  std::condition_variable idle_;
+  std::thread thread_;
+};
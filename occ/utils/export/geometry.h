@@ -51,6 +51,19 @@ constexpr bool is_any_colliding(const std::vector<Rectangle>& v, const Rectangle
   };
   return std::any_of(v.cbegin(), v.cend(), Collides(a));
 }
+// Returns the overlapping part of Rectangle a and Rectangle b, or an empty Rectangle if they don't intersect
+constexpr Rectangle intersection(const Rectangle& a, const Rectangle& b)
+{
+  if (!isColliding(a, b))
+  {
+    return Rectangle();
+  }
+  const int x = std::max(a.position.x(), b.position.x());
+  const int y = std::max(a.position.y(), b.position.y());
+  const int right = std::min(a.position.x() + a.size.x(), b.position.x() + b.size.x());
+  const int bottom = std::min(a.position.y() + a.size.y(), b.position.y() + b.size.y());
+  return Rectangle(x, y, right - x, bottom - y);
+}
 // Returns true if A is within B
 constexpr bool is_inside(const Rectangle& a, const Rectangle& b)
 {
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/// Records how long named phases take, relative to when the profiler was created
+/// Phases may be recorded from any thread
+class Profiler
+{
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  struct Phase
+  {
+    std::string name;
+    double start_ms;
+    double duration_ms;
+  };
+
+  /// Records the phase from construction until destruction
+  class Scope
+  {
+   public:
+    Scope(Profiler& profiler, std::string name) : profiler_(profiler), name_(std::move(name)), start_(Clock::now()) {}
+    ~Scope() { profiler_.record(name_, start_, Clock::now()); }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+   private:
+    Profiler& profiler_;
+    std::string name_;
+    Clock::time_point start_;
+  };
+
+  Profiler() : start_(Clock::now()), last_lap_(start_) {}
+
+  Scope scope(std::string name) { return Scope(*this, std::move(name)); }
+  void record(const std::string& name, const Clock::time_point start, const Clock::time_point end);
+  // Records a phase from the profiler creation until now, e.g. "first_frame"
+  void mark(const std::string& name);
+  // Records a phase from the end of the previous lap (or the profiler creation) until now
+  void lap(const std::string& name);
+
+  // Phases in the order they finished
+  std::vector<Phase> phases() const;
+  // One "name,start_ms,duration_ms" line per phase, after a header line
+  std::string report() const;
+
+ private:
+  Clock::time_point start_;
+  Clock::time_point last_lap_;
+  mutable std::mutex mutex_;
+  std::vector<Phase> phases_;
+};
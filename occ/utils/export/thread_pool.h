@@ -0,0 +1,36 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// Fixed set of worker threads running posted jobs in FIFO order
+class ThreadPool
+{
+ public:
+  // num_threads == 0 means one thread per hardware thread (at least one)
+  explicit ThreadPool(unsigned num_threads = 0);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  void post(std::function<void()> job);
+  // Blocks until all posted jobs have finished
+  void wait_idle();
+  size_t size() const { return threads_.size(); }
+
+ private:
+  void run();
+
+  std::vector<std::thread> threads_;
+  std::deque<std::function<void()>> jobs_;
+  std::mutex mutex_;
+  std::condition_variable job_available_;
+  std::condition_variable idle_;
+  unsigned busy_ = 0;
+  bool stopping_ = false;
+};
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/// Hierarchical timer wheel: scheduling, cancelling and advancing a tick don't depend on how many timers there are
+/// The first level has a slot per tick for the current block of 256 ticks, the second level a slot per block of
+/// 256 ticks for the current 65536 ticks, and timers further away wait in an overflow list
+/// Timers due on the same tick fire in the order they were scheduled, also when they waited on different levels
+template <typename T>
+class TimerWheel
+{
+ public:
+  explicit TimerWheel(uint64_t now = 0) : now_(now) {}
+
+  uint64_t now() const { return now_; }
+  size_t size() const { return size_; }
+
+  // Timers due now or earlier fire on the next advance()
+  // Returns the tick the timer will fire on, needed to cancel it
+  uint64_t schedule(uint64_t tick, const T& value)
+  {
+    tick = std::max(tick, now_ + 1);
+    if (same_block(tick, 0))
+    {
+      level0_[tick & SLOT_MASK].push_back(value);
+    }
+    else if (same_block(tick, 1))
+    {
+      level1_[(tick >> SLOT_BITS) & SLOT_MASK].emplace_back(tick, value);
+    }
+    else
+    {
+      overflow_.emplace_back(tick, value);
+    }
+    size_++;
+    return tick;
+  }
+
+  // Returns false if there is no such timer
+  bool cancel(uint64_t tick, const T& value)
+  {
+    bool found = false;
+    if (same_block(tick, 0))
+    {
+      found = erase_first(level0_[tick & SLOT_MASK], [&value](const T& v) { return v == value; });
+    }
+    else if (same_block(tick, 1))
+    {
+      found = erase_first(level1_[(tick >> SLOT_BITS) & SLOT_MASK],
+                          [&](const std::pair<uint64_t, T>& timer) { return timer.first == tick && timer.second == value; });
+    }
+    else
+    {
+      found = erase_first(overflow_, [&](const std::pair<uint64_t, T>& timer) { return timer.first == tick && timer.second == value; });
+    }
+    if (found)
+    {
+      size_--;
+    }
+    return found;
+  }
+
+  // Moves to the next tick and calls fn(value) for each timer due on it
+  template <typename F>
+  void advance(F&& fn)
+  {
+    now_++;
+    if ((now_ & SLOT_MASK) == 0)
+    {
+      // Entering a new block: move its timers down a level
+      // Each slot they move into was emptied when its previous block was entered, and nothing was scheduled into it since:
+      // a tick only goes into a lower level once it is in the current block of that level. So timers keep their order,
+      // and the ones that waited longer, on a higher level, were scheduled before the ones already below
+      if (((now_ >> SLOT_BITS) & SLOT_MASK) == 0)
+      {
+        auto keep = overflow_.begin();
+        for (auto& timer : overflow_)
+        {
+          if (same_block(timer.first, 1))
+          {
+            level1_[(timer.first >> SLOT_BITS) & SLOT_MASK].push_back(std::move(timer));
+          }
+          else
+          {
+            *keep++ = std::move(timer);
+          }
+        }
+        overflow_.erase(keep, overflow_.end());
+      }
+      auto& slot = level1_[(now_ >> SLOT_BITS) & SLOT_MASK];
+      for (auto& timer : slot)
+      {
+        level0_[timer.first & SLOT_MASK].push_back(std::move(timer.second));
+      }
+      slot.clear();
+    }
+
+    // Timers scheduled by fn are due later, so they never go into the slot being fired
+    due_.swap(level0_[now_ & SLOT_MASK]);
+    size_ -= due_.size();
+    for (const auto& value : due_)
+    {
+      fn(value);
+    }
+    due_.clear();
+  }
+
+ private:
+  static constexpr int SLOT_BITS = 8;
+  static constexpr uint64_t SLOT_MASK = (1u << SLOT_BITS) - 1;
+
+  // Whether tick is in the same block as now on the given level
+  bool same_block(uint64_t tick, int level) const { return (tick >> (SLOT_BITS * (level + 1))) == (now_ >> (SLOT_BITS * (level + 1))); }
+
+  template <typename V, typename P>
+  static bool erase_first(std::vector<V>& values, P&& pred)
+  {
+    const auto it = std::find_if(values.begin(), values.end(), pred);
+    if (it == values.end())
+    {
+      return false;
+    }
+    values.erase(it);
+    return true;
+  }
+
+  uint64_t now_;
+  size_t size_ = 0;
+  std::array<std::vector<T>, 1u << SLOT_BITS> level0_;
+  std::array<std::vector<std::pair<uint64_t, T>>, 1u << SLOT_BITS> level1_;
+  std::vector<std::pair<uint64_t, T>> overflow_;
+  std::vector<T> due_;
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+
+/// Lock-free handoff of the latest value from one producer thread to one consumer thread
+/// The producer fills write_buffer() and publishes it, the consumer read()s the latest published buffer
+/// Neither side ever waits for the other; values published while the consumer is busy are skipped
+/// Buffers are reused, so containers in T keep their allocations between publishes
+template <typename T>
+class TripleBuffer
+{
+ public:
+  TripleBuffer() = default;
+
+  TripleBuffer(const TripleBuffer&) = delete;
+  TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+  // Producer side: the buffer to fill, it holds an old value that must be overwritten completely
+  T& write_buffer() { return buffers_[write_]; }
+  void publish()
+  {
+    // Swap the filled buffer into the middle slot, and mark it as new for the consumer
+    write_ = middle_.exchange(write_ | NEW_BIT, std::memory_order_acq_rel) & INDEX_MASK;
+  }
+
+  // Consumer side: the latest published buffer (default constructed until the first publish)
+  // The reference stays valid until the next read()
+  const T& read()
+  {
+    if (middle_.load(std::memory_order_relaxed) & NEW_BIT)
+    {
+      read_ = middle_.exchange(read_, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+    return buffers_[read_];
+  }
+  // Whether a buffer has been published since the last read()
+  bool has_new() const { return middle_.load(std::memory_order_relaxed) & NEW_BIT; }
+
+ private:
+  static constexpr unsigned INDEX_MASK = 3;
+  static constexpr unsigned NEW_BIT = 4;
+
+  std::array<T, 3> buffers_ = {};
+  unsigned write_ = 0;
+  std::atomic<unsigned> middle_ = 1;
+  unsigned read_ = 2;
+};
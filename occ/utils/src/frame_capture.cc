@@ -0,0 +1,279 @@
+#include "frame_capture.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+
+#include "logger.h"
+
+namespace
+{
+
+constexpr std::array<uint32_t, 256> make_crc_table()
+{
+  std::array<uint32_t, 256> table = {};
+  for (uint32_t n = 0; n < 256; n++)
+  {
+    auto c = n;
+    for (int k = 0; k < 8; k++)
+    {
+      c = (c & 1u) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+    }
+    table[n] = c;
+  }
+  return table;
+}
+
+constexpr auto crc_table = make_crc_table();
+
+uint32_t crc32(uint32_t crc, const uint8_t* data, size_t length)
+{
+  for (size_t i = 0; i < length; i++)
+  {
+    crc = crc_table[(crc ^ data[i]) & 0xffu] ^ (crc >> 8);
+  }
+  return crc;
+}
+
+void put_u32(std::vector<uint8_t>& out, uint32_t value)
+{
+  out.push_back(static_cast<uint8_t>(value >> 24));
+  out.push_back(static_cast<uint8_t>(value >> 16));
+  out.push_back(static_cast<uint8_t>(value >> 8));
+  out.push_back(static_cast<uint8_t>(value));
+}
+
+// Writes length, type, data and CRC of the chunk whose type and data start at out[start]
+void write_png_chunk(std::ostream& os, const std::vector<uint8_t>& out, size_t start)
+{
+  const auto length = static_cast<uint32_t>(out.size() - start - 4);
+  const uint8_t length_bytes[] = {static_cast<uint8_t>(length >> 24),
+                                  static_cast<uint8_t>(length >> 16),
+                                  static_cast<uint8_t>(length >> 8),
+                                  static_cast<uint8_t>(length)};
+  os.write(reinterpret_cast<const char*>(length_bytes), 4);
+  os.write(reinterpret_cast<const char*>(out.data() + start), out.size() - start);
+  const auto crc = crc32(0xffffffffu, out.data() + start, out.size() - start) ^ 0xffffffffu;
+  const uint8_t crc_bytes[] = {
+    static_cast<uint8_t>(crc >> 24), static_cast<uint8_t>(crc >> 16), static_cast<uint8_t>(crc >> 8), static_cast<uint8_t>(crc)};
+  os.write(reinterpret_cast<const char*>(crc_bytes), 4);
+}
+
+}  // namespace
+
+std::unique_ptr<FrameCapture> FrameCapture::create(const std::filesystem::path& path, geometry::Size size, unsigned fps_num, unsigned fps_den)
+{
+  if (path.extension() == ".y4m")
+  {
+    auto capture = std::make_unique<FrameCapture>(path, Format::Y4M, size, fps_num, fps_den);
+    if (!capture->stream_)
+    {
+      LOG_ERROR("could not open %s for writing", path.string().c_str());
+      return nullptr;
+    }
+    return capture;
+  }
+  std::error_code error;
+  std::filesystem::create_directories(path, error);
+  if (error)
+  {
+    LOG_ERROR("could not create directory %s: %s", path.string().c_str(), error.message().c_str());
+    return nullptr;
+  }
+  return std::make_unique<FrameCapture>(path, Format::PNG, size, fps_num, fps_den);
+}
+
+FrameCapture::FrameCapture(const std::filesystem::path& path,
+                           Format format,
+                           geometry::Size size,
+                           unsigned fps_num,
+                           unsigned fps_den,
+                           unsigned num_buffers)
+  : path_(path),
+    format_(format),
+    size_(size),
+    buffers_(num_buffers, std::vector<uint32_t>(size.x() * size.y()))
+{
+  if (format_ == Format::Y4M)
+  {
+    stream_.open(path_, std::ios::binary);
+    write_y4m_header(stream_, size_, fps_num, fps_den);
+  }
+  thread_ = std::thread(&FrameCapture::run, this);
+}
+
+FrameCapture::~FrameCapture()
+{
+  {
+    std::unique_lock lock(mutex_);
+    stopping_ = true;
+  }
+  frame_available_.notify_all();
+  thread_.join();
+}
+
+std::vector<uint32_t>* FrameCapture::acquire()
+{
+  std::unique_lock lock(mutex_);
+  if (num_queued_ == buffers_.size())
+  {
+    frames_dropped_++;
+    return nullptr;
+  }
+  return &buffers_[(first_queued_ + num_queued_) % buffers_.size()];
+}
+
+void FrameCapture::submit()
+{
+  {
+    std::unique_lock lock(mutex_);
+    num_queued_++;
+  }
+  frame_available_.notify_one();
+}
+
+void FrameCapture::wait_idle()
+{
+  std::unique_lock lock(mutex_);
+  idle_.wait(lock, [this] { return num_queued_ == 0; });
+}
+
+void FrameCapture::run()
+{
+  while (true)
+  {
+    std::unique_lock lock(mutex_);
+    frame_available_.wait(lock, [this] { return num_queued_ > 0 || stopping_; });
+    if (num_queued_ == 0)
+    {
+      // Stopping, and all frames have been written
+      return;
+    }
+    // The buffer stays queued while it's being written so that acquire() doesn't hand it out
+    const auto& pixels = buffers_[first_queued_];
+    lock.unlock();
+
+    write(pixels, frames_written_);
+
+    lock.lock();
+    first_queued_ = (first_queued_ + 1) % buffers_.size();
+    num_queued_--;
+    frames_written_++;
+    if (num_queued_ == 0)
+    {
+      idle_.notify_all();
+    }
+  }
+}
+
+void FrameCapture::write(const std::vector<uint32_t>& pixels, unsigned frame)
+{
+  switch (format_)
+  {
+    case Format::PNG:
+    {
+      char name[32];
+      snprintf(name, sizeof name, "frame_%06u.png", frame);
+      const auto filename = path_ / name;
+      std::ofstream os(filename, std::ios::binary);
+      if (!os)
+      {
+        LOG_ERROR("could not open %s for writing", filename.string().c_str());
+        return;
+      }
+      write_png(os, size_, pixels.data(), scratch_);
+      break;
+    }
+    case Format::Y4M:
+      write_y4m_frame(stream_, size_, pixels.data(), scratch_);
+      break;
+  }
+}
+
+void FrameCapture::write_png(std::ostream& os, geometry::Size size, const uint32_t* pixels, std::vector<uint8_t>& scratch)
+{
+  static constexpr uint8_t signature[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+  os.write(reinterpret_cast<const char*>(signature), sizeof(signature));
+
+  // IHDR: 8 bit RGB, no interlacing
+  scratch.clear();
+  scratch.insert(scratch.end(), {'I', 'H', 'D', 'R'});
+  put_u32(scratch, size.x());
+  put_u32(scratch, size.y());
+  scratch.insert(scratch.end(), {8, 2, 0, 0, 0});
+  write_png_chunk(os, scratch, 0);
+
+  // IDAT: zlib stream of stored (uncompressed) deflate blocks, each row prefixed with filter type 0
+  // Compression would cost more time than the capture is meant to take
+  scratch.clear();
+  scratch.insert(scratch.end(), {'I', 'D', 'A', 'T', 0x78, 0x01});
+  const size_t row_size = 1 + size.x() * 3;
+  const size_t raw_size = row_size * size.y();
+  const auto raw_start = scratch.size();
+  scratch.reserve(raw_start + raw_size + (raw_size / 0xffff + 1) * 5 + 4);
+  uint32_t adler_a = 1;
+  uint32_t adler_b = 0;
+  size_t block_remaining = 0;
+  size_t total_remaining = raw_size;
+  const auto put_byte = [&](const uint8_t byte)
+  {
+    if (block_remaining == 0)
+    {
+      block_remaining = std::min<size_t>(total_remaining, 0xffff);
+      total_remaining -= block_remaining;
+      const auto length = static_cast<uint16_t>(block_remaining);
+      scratch.insert(scratch.end(),
+                     {static_cast<uint8_t>(total_remaining == 0 ? 1 : 0),
+                      static_cast<uint8_t>(length),
+                      static_cast<uint8_t>(length >> 8),
+                      static_cast<uint8_t>(~length),
+                      static_cast<uint8_t>(~length >> 8)});
+    }
+    scratch.push_back(byte);
+    block_remaining--;
+    adler_a = (adler_a + byte) % 65521u;
+    adler_b = (adler_b + adler_a) % 65521u;
+  };
+  for (int y = 0; y < size.y(); y++)
+  {
+    put_byte(0);
+    for (int x = 0; x < size.x(); x++)
+    {
+      const auto pixel = pixels[y * size.x() + x];
+      put_byte(static_cast<uint8_t>(pixel >> 16));
+      put_byte(static_cast<uint8_t>(pixel >> 8));
+      put_byte(static_cast<uint8_t>(pixel));
+    }
+  }
+  put_u32(scratch, (adler_b << 16) | adler_a);
+  write_png_chunk(os, scratch, 0);
+
+  scratch.clear();
+  scratch.insert(scratch.end(), {'I', 'E', 'N', 'D'});
+  write_png_chunk(os, scratch, 0);
+}
+
+void FrameCapture::write_y4m_header(std::ostream& os, geometry::Size size, unsigned fps_num, unsigned fps_den)
+{
+  char header[64];
+  snprintf(header, sizeof header, "YUV4MPEG2 W%d H%d F%u:%u Ip A1:1 C444\n", size.x(), size.y(), fps_num, fps_den);
+  os << header;
+}
+
+void FrameCapture::write_y4m_frame(std::ostream& os, geometry::Size size, const uint32_t* pixels, std::vector<uint8_t>& scratch)
+{
+  // BT.601 limited range, full resolution chroma
+  const size_t plane_size = size.x() * size.y();
+  scratch.resize(plane_size * 3);
+  for (size_t i = 0; i < plane_size; i++)
+  {
+    const int r = (pixels[i] >> 16) & 0xff;
+    const int g = (pixels[i] >> 8) & 0xff;
+    const int b = pixels[i] & 0xff;
+    scratch[i] = static_cast<uint8_t>(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+    scratch[plane_size + i] = static_cast<uint8_t>(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+    scratch[plane_size * 2 + i] = static_cast<uint8_t>(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+  }
+  os << "FRAME\n";
+  os.write(reinterpret_cast<const char*>(scratch.data()), scratch.size());
+}
@@ -0,0 +1,48 @@
+#include "profiler.h"
+
+#include <cstdio>
+
+namespace
+{
+double to_ms(const Profiler::Clock::duration duration)
+{
+  return std::chrono::duration<double, std::milli>(duration).count();
+}
+}
+
+void Profiler::record(const std::string& name, const Clock::time_point start, const Clock::time_point end)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  phases_.push_back({name, to_ms(start - start_), to_ms(end - start)});
+}
+
+void Profiler::mark(const std::string& name)
+{
+  record(name, start_, Clock::now());
+}
+
+void Profiler::lap(const std::string& name)
+{
+  const auto now = Clock::now();
+  std::lock_guard<std::mutex> lock(mutex_);
+  phases_.push_back({name, to_ms(last_lap_ - start_), to_ms(now - last_lap_)});
+  last_lap_ = now;
+}
+
+std::vector<Profiler::Phase> Profiler::phases() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return phases_;
+}
+
+std::string Profiler::report() const
+{
+  std::string out = "phase,start_ms,duration_ms\n";
+  char line[256];
+  for (const auto& phase : phases())
+  {
+    snprintf(line, sizeof line, "%s,%.3f,%.3f\n", phase.name.c_str(), phase.start_ms, phase.duration_ms);
+    out += line;
+  }
+  return out;
+}
@@ -0,0 +1,72 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(unsigned num_threads)
+{
+  if (num_threads == 0)
+  {
+    num_threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  for (unsigned i = 0; i < num_threads; i++)
+  {
+    threads_.emplace_back(&ThreadPool::run, this);
+  }
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  job_available_.notify_all();
+  for (auto& thread : threads_)
+  {
+    thread.join();
+  }
+}
+
+void ThreadPool::post(std::function<void()> job)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    jobs_.push_back(std::move(job));
+  }
+  job_available_.notify_one();
+}
+
+void ThreadPool::wait_idle()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  idle_.wait(lock, [this] { return jobs_.empty() && busy_ == 0; });
+}
+
+void ThreadPool::run()
+{
+  while (true)
+  {
+    std::function<void()> job;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      job_available_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+      // Finish the queued jobs before stopping
+      if (jobs_.empty())
+      {
+        return;
+      }
+      job = std::move(jobs_.front());
+      jobs_.pop_front();
+      busy_++;
+    }
+    job();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      busy_--;
+      if (jobs_.empty() && busy_ == 0)
+      {
+        idle_.notify_all();
+      }
+    }
+  }
+}
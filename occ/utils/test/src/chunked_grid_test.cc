@@ -0,0 +1,38 @@
+#include <gtest/gtest.h>
+
+#include "chunked_grid.h"
+
+TEST(ChunkedGrid, get_set)
+{
+  ChunkedGrid<int> grid(100, 40, -1);
+  EXPECT_EQ(100, grid.width());
+  EXPECT_EQ(40, grid.height());
+
+  // Nothing is allocated until written
+  EXPECT_EQ(-1, grid.get(50, 20));
+  EXPECT_EQ(0u, grid.num_chunks_in_memory());
+
+  grid.set(0, 0, 1);
+  grid.set(31, 31, 2);
+  grid.set(32, 31, 3);
+  grid.set(99, 39, 4);
+  EXPECT_EQ(3u, grid.num_chunks_in_memory());
+  EXPECT_EQ(1, grid.get(0, 0));
+  EXPECT_EQ(2, grid.get(31, 31));
+  EXPECT_EQ(3, grid.get(32, 31));
+  EXPECT_EQ(4, grid.get(99, 39));
+  EXPECT_EQ(-1, grid.get(1, 0));
+
+  // Writing the fill value doesn't allocate a chunk, but does overwrite in an allocated one
+  grid.set(50, 20, -1);
+  EXPECT_EQ(3u, grid.num_chunks_in_memory());
+  grid.set(31, 31, -1);
+  EXPECT_EQ(-1, grid.get(31, 31));
+
+  // Outside the grid
+  grid.set(100, 0, 5);
+  grid.set(-1, 0, 5);
+  EXPECT_EQ(-1, grid.get(100, 0));
+  EXPECT_EQ(-1, grid.get(0, -1));
+  EXPECT_EQ(3u, grid.num_chunks_in_memory());
+}
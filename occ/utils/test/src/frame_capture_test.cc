@@ -0,0 +1,66 @@
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "frame_capture.h"
+
+TEST(FrameCapture, y4m_frame)
+{
+  std::ostringstream os;
+  std::vector<uint8_t> scratch;
+  const uint32_t pixels[] = {0xffffffffu, 0xff000000u};
+  FrameCapture::write_y4m_header(os, geometry::Size(2, 1), 35, 2);
+  FrameCapture::write_y4m_frame(os, geometry::Size(2, 1), pixels, scratch);
+  const auto header = std::string("YUV4MPEG2 W2 H1 F35:2 Ip A1:1 C444\nFRAME\n");
+  // Y, then U, then V planes
+  const auto expected = header + std::string("\xeb\x10\x80\x80\x80\x80", 6);
+  EXPECT_EQ(expected, os.str());
+}
+
+TEST(FrameCapture, png_stored_blocks)
+{
+  std::ostringstream os;
+  std::vector<uint8_t> scratch;
+  const uint32_t pixels[] = {0xff112233u, 0xff445566u};
+  FrameCapture::write_png(os, geometry::Size(1, 2), pixels, scratch);
+  const auto png = os.str();
+
+  EXPECT_EQ(std::string("\x89PNG\r\n\x1a\n", 8), png.substr(0, 8));
+  EXPECT_EQ("IHDR", png.substr(12, 4));
+  // Rows are stored uncompressed, each prefixed by filter type 0
+  const auto idat = png.find("IDAT");
+  ASSERT_NE(std::string::npos, idat);
+  EXPECT_EQ(std::string("\x78\x01\x01\x08\x00\xf7\xff\x00\x11\x22\x33\x00\x44\x55\x66", 15), png.substr(idat + 4, 15));
+  EXPECT_EQ("IEND", png.substr(png.size() - 8, 4));
+  // Signature, IHDR, IDAT (zlib header, block header, 8 bytes, adler32) and IEND
+  EXPECT_EQ(8u + 25u + 12u + 2u + 5u + 8u + 4u + 12u, png.size());
+}
+
+TEST(FrameCapture, writes_submitted_frames)
+{
+  const auto path = std::filesystem::temp_directory_path() / "frame_capture_test.y4m";
+  {
+    auto capture = FrameCapture::create(path, geometry::Size(4, 2), 60, 1);
+    ASSERT_TRUE(capture);
+    for (int i = 0; i < 3; i++)
+    {
+      // Buffers are allocated up front and reused
+      auto* pixels = capture->acquire();
+      if (pixels)
+      {
+        EXPECT_EQ(8u, pixels->size());
+        pixels->assign(8, 0xff000000u);
+        capture->submit();
+      }
+    }
+    capture->wait_idle();
+    EXPECT_EQ(3u, capture->frames_written() + capture->frames_dropped());
+  }
+  const auto header_size = std::string("YUV4MPEG2 W4 H2 F60:1 Ip A1:1 C444\n").size();
+  EXPECT_EQ(header_size + 3 * (6 + 8 * 3), std::filesystem::file_size(path));
+  std::filesystem::remove(path);
+}
@@ -56,3 +56,21 @@ TEST(Rectangle, Colliding)
   EXPECT_FALSE(geometry::isColliding(b, c));
   EXPECT_FALSE(geometry::isColliding(c, b));
 }
+
+TEST(Rectangle, Intersection)
+{
+  const geometry::Rectangle a(0, 0, 16, 16);
+  const geometry::Rectangle b(8, 4, 16, 4);
+  const geometry::Rectangle c(20, 20, 2, 2);
+
+  const auto ab = geometry::intersection(a, b);
+  EXPECT_EQ(8, ab.position.x());
+  EXPECT_EQ(4, ab.position.y());
+  EXPECT_EQ(8, ab.size.x());
+  EXPECT_EQ(4, ab.size.y());
+
+  // Rectangles that don't collide have an empty intersection
+  const auto ac = geometry::intersection(a, c);
+  EXPECT_EQ(0, ac.size.x());
+  EXPECT_EQ(0, ac.size.y());
+}
@@ -0,0 +1,56 @@
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "profiler.h"
+
+TEST(Profiler, scope)
+{
+  Profiler profiler;
+  {
+    const auto scope = profiler.scope("sleep");
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  const auto phases = profiler.phases();
+  ASSERT_EQ(1u, phases.size());
+  EXPECT_EQ("sleep", phases[0].name);
+  EXPECT_GE(phases[0].start_ms, 0.0);
+  EXPECT_GE(phases[0].duration_ms, 5.0);
+}
+
+TEST(Profiler, mark)
+{
+  Profiler profiler;
+  {
+    const auto scope = profiler.scope("first");
+  }
+  profiler.mark("total");
+  const auto phases = profiler.phases();
+  ASSERT_EQ(2u, phases.size());
+  EXPECT_EQ("total", phases[1].name);
+  EXPECT_DOUBLE_EQ(0.0, phases[1].start_ms);
+  EXPECT_GE(phases[1].duration_ms, phases[0].start_ms + phases[0].duration_ms);
+}
+
+TEST(Profiler, lap)
+{
+  Profiler profiler;
+  profiler.lap("one");
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  profiler.lap("two");
+  const auto phases = profiler.phases();
+  ASSERT_EQ(2u, phases.size());
+  EXPECT_DOUBLE_EQ(0.0, phases[0].start_ms);
+  EXPECT_DOUBLE_EQ(phases[0].duration_ms, phases[1].start_ms);
+  EXPECT_GE(phases[1].duration_ms, 2.0);
+}
+
+TEST(Profiler, report)
+{
+  Profiler profiler;
+  const auto now = Profiler::Clock::now();
+  profiler.record("a", now, now + std::chrono::milliseconds(2));
+  const auto report = profiler.report();
+  EXPECT_EQ(0u, report.find("phase,start_ms,duration_ms\na,"));
+  EXPECT_NE(std::string::npos, report.find(",2.000\n"));
+}
@@ -0,0 +1,45 @@
+#include <atomic>
+
+#include <gtest/gtest.h>
+
+#include "thread_pool.h"
+
+TEST(ThreadPool, runs_all_jobs)
+{
+  ThreadPool pool(4);
+  EXPECT_EQ(4u, pool.size());
+  std::atomic<int> sum = 0;
+  for (int i = 1; i <= 100; i++)
+  {
+    pool.post([&sum, i] { sum += i; });
+  }
+  pool.wait_idle();
+  EXPECT_EQ(5050, sum);
+}
+
+TEST(ThreadPool, jobs_can_post_jobs)
+{
+  ThreadPool pool(2);
+  std::atomic<int> count = 0;
+  pool.post(
+    [&pool, &count]
+    {
+      count++;
+      pool.post([&count] { count++; });
+    });
+  pool.wait_idle();
+  EXPECT_EQ(2, count);
+}
+
+TEST(ThreadPool, destructor_finishes_queued_jobs)
+{
+  std::atomic<int> count = 0;
+  {
+    ThreadPool pool(1);
+    for (int i = 0; i < 10; i++)
+    {
+      pool.post([&count] { count++; });
+    }
+  }
+  EXPECT_EQ(10, count);
+}
@@ -0,0 +1,117 @@
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "timer_wheel.h"
+
+namespace
+{
+
+// Advances the wheel to tick and returns (tick, value) for every timer fired on the way
+std::vector<std::pair<uint64_t, int>> advance_to(TimerWheel<int>& wheel, uint64_t tick)
+{
+  std::vector<std::pair<uint64_t, int>> fired;
+  while (wheel.now() < tick)
+  {
+    wheel.advance([&](const int value) { fired.emplace_back(wheel.now(), value); });
+  }
+  return fired;
+}
+
+}  // namespace
+
+TEST(TimerWheel, fires_on_due_tick)
+{
+  TimerWheel<int> wheel;
+  EXPECT_EQ(3u, wheel.schedule(3, 1));
+  wheel.schedule(1, 2);
+  wheel.schedule(3, 3);
+  EXPECT_EQ(3u, wheel.size());
+
+  // Same tick in the order scheduled
+  const std::vector<std::pair<uint64_t, int>> expected = {{1, 2}, {3, 1}, {3, 3}};
+  EXPECT_EQ(expected, advance_to(wheel, 10));
+  EXPECT_EQ(0u, wheel.size());
+}
+
+TEST(TimerWheel, past_ticks_fire_next)
+{
+  TimerWheel<int> wheel(100);
+  EXPECT_EQ(101u, wheel.schedule(50, 1));
+  EXPECT_EQ(101u, wheel.schedule(100, 2));
+  const std::vector<std::pair<uint64_t, int>> expected = {{101, 1}, {101, 2}};
+  EXPECT_EQ(expected, advance_to(wheel, 101));
+}
+
+TEST(TimerWheel, far_timers_cascade)
+{
+  // Timers in each level, including across the end of the second level
+  TimerWheel<int> wheel(65000);
+  wheel.schedule(65100, 1);
+  wheel.schedule(65300, 2);
+  wheel.schedule(65536, 3);
+  wheel.schedule(65537, 4);
+  wheel.schedule(200000, 5);
+  wheel.schedule(65300, 6);
+  const std::vector<std::pair<uint64_t, int>> expected = {{65100, 1}, {65300, 2}, {65300, 6}, {65536, 3}, {65537, 4}, {200000, 5}};
+  EXPECT_EQ(expected, advance_to(wheel, 300000));
+}
+
+TEST(TimerWheel, cascade_keeps_scheduling_order)
+{
+  // Timers due on the same tick, scheduled while it was in the overflow list, the second level and the first level
+  constexpr uint64_t tick = 65536 + 300;
+  TimerWheel<int> wheel;
+  wheel.schedule(tick, 1);
+  wheel.schedule(tick + 1, 2);
+  advance_to(wheel, 65535);
+  wheel.schedule(tick, 3);
+  advance_to(wheel, 65536 + 10);
+  wheel.schedule(tick, 4);
+  wheel.schedule(tick + 1, 5);
+  advance_to(wheel, 65536 + 256 + 5);
+  wheel.schedule(tick, 6);
+  const std::vector<std::pair<uint64_t, int>> expected = {{tick, 1}, {tick, 3}, {tick, 4}, {tick, 6}, {tick + 1, 2}, {tick + 1, 5}};
+  EXPECT_EQ(expected, advance_to(wheel, tick + 1));
+}
+
+TEST(TimerWheel, cancel)
+{
+  TimerWheel<int> wheel;
+  const auto near = wheel.schedule(10, 1);
+  const auto mid = wheel.schedule(1000, 2);
+  const auto far = wheel.schedule(100000, 3);
+  wheel.schedule(1000, 4);
+
+  EXPECT_TRUE(wheel.cancel(near, 1));
+  EXPECT_FALSE(wheel.cancel(near, 1));
+  EXPECT_FALSE(wheel.cancel(mid, 3));
+  EXPECT_TRUE(wheel.cancel(far, 3));
+  // After cascading into the first level
+  advance_to(wheel, 999);
+  EXPECT_TRUE(wheel.cancel(mid, 2));
+  EXPECT_EQ(1u, wheel.size());
+
+  const std::vector<std::pair<uint64_t, int>> expected = {{1000, 4}};
+  EXPECT_EQ(expected, advance_to(wheel, 200000));
+}
+
+TEST(TimerWheel, schedule_while_firing)
+{
+  TimerWheel<int> wheel;
+  wheel.schedule(1, 0);
+  std::vector<uint64_t> fired;
+  while (wheel.now() < 1000)
+  {
+    // Every timer schedules the next one 300 ticks later
+    wheel.advance(
+      [&](const int value)
+      {
+        fired.push_back(wheel.now());
+        wheel.schedule(wheel.now() + 300, value + 1);
+      });
+  }
+  EXPECT_EQ((std::vector<uint64_t>{1, 301, 601, 901}), fired);
+}
@@ -0,0 +1,78 @@
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "triple_buffer.h"
+
+TEST(TripleBuffer, read_returns_latest_published)
+{
+  TripleBuffer<int> buffer;
+  EXPECT_FALSE(buffer.has_new());
+  EXPECT_EQ(0, buffer.read());
+
+  buffer.write_buffer() = 1;
+  buffer.publish();
+  buffer.write_buffer() = 2;
+  buffer.publish();
+  EXPECT_TRUE(buffer.has_new());
+  EXPECT_EQ(2, buffer.read());
+  EXPECT_FALSE(buffer.has_new());
+
+  // Nothing new: the same value again
+  EXPECT_EQ(2, buffer.read());
+
+  // Unpublished writes are not visible
+  buffer.write_buffer() = 3;
+  EXPECT_EQ(2, buffer.read());
+  buffer.publish();
+  EXPECT_EQ(3, buffer.read());
+}
+
+TEST(TripleBuffer, read_buffer_is_not_written)
+{
+  TripleBuffer<std::vector<int>> buffer;
+  buffer.write_buffer() = {1, 2, 3};
+  buffer.publish();
+  const auto& read = buffer.read();
+
+  // However often the producer publishes, the buffer being read is left alone
+  for (int i = 0; i < 10; i++)
+  {
+    EXPECT_NE(&read, &buffer.write_buffer());
+    buffer.write_buffer().assign(3, i);
+    buffer.publish();
+  }
+  EXPECT_EQ((std::vector<int>{1, 2, 3}), read);
+  EXPECT_EQ((std::vector<int>{9, 9, 9}), buffer.read());
+}
+
+TEST(TripleBuffer, threads)
+{
+  // Each published value is consistent and values never go backwards
+  struct Value
+  {
+    int a = 0;
+    int b = 0;
+  };
+  TripleBuffer<Value> buffer;
+  constexpr int num_values = 100000;
+  std::thread producer(
+    [&buffer]
+    {
+      for (int i = 1; i <= num_values; i++)
+      {
+        buffer.write_buffer() = {i, -i};
+        buffer.publish();
+      }
+    });
+  int last = 0;
+  while (last < num_values)
+  {
+    const auto& value = buffer.read();
+    ASSERT_EQ(value.a, -value.b);
+    ASSERT_GE(value.a, last);
+    last = value.a;
+  }
+  producer.join();
+}